@@ -0,0 +1,111 @@
+#include "delegate/actor.hpp"
+
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+namespace
+{
+constexpr std::size_t actorCount = 10000;
+
+struct Counter
+{
+    void add(int v)
+    {
+        total += v;
+        done->count_down();
+    }
+    long total = 0;
+    delegate_latch* done = nullptr;
+};
+
+// One message to each of 10k actors per iteration, from the bench thread.
+void
+BM_actor_fan_out(benchmark::State& state)
+{
+    thread_pool pool{static_cast<std::size_t>(state.range(0))};
+    std::vector<std::unique_ptr<actor<Counter>>> actors;
+    for (std::size_t i = 0; i < actorCount; ++i)
+        actors.emplace_back(new actor<Counter>{pool});
+    std::vector<mail<void(int)>> mails(actorCount);
+    for (auto _ : state)
+    {
+        delegate_latch done{static_cast<std::ptrdiff_t>(actorCount)};
+        for (std::size_t i = 0; i < actorCount; ++i)
+        {
+            actors[i]->get().done = &done;
+            actors[i]->tell<&Counter::add>(mails[i], 1);
+        }
+        pool.wait(done);
+    }
+    state.SetItemsProcessed(state.iterations() * actorCount);
+}
+
+// Baseline: a mutex per object, called directly by the same thread.
+void
+BM_mutex_per_object(benchmark::State& state)
+{
+    struct Locked
+    {
+        std::mutex mutex;
+        Counter counter;
+    };
+    std::vector<Locked> objects(actorCount);
+    for (auto _ : state)
+    {
+        delegate_latch done{static_cast<std::ptrdiff_t>(actorCount)};
+        for (auto& o : objects)
+        {
+            std::lock_guard<std::mutex> lock(o.mutex);
+            o.counter.done = &done;
+            o.counter.add(1);
+        }
+        done.wait();
+    }
+    state.SetItemsProcessed(state.iterations() * actorCount);
+}
+
+struct Player
+{
+    void hit(int remaining)
+    {
+        if (remaining == 0)
+            done->count_down();
+        else
+            other->tell<&Player::hit>(*ball, remaining - 1);
+    }
+    actor<Player>* other = nullptr;
+    mail<void(int)>* ball = nullptr;
+    delegate_latch* done = nullptr;
+};
+
+// Round trip time between two actors on a pool of range(0) workers.
+void
+BM_actor_ping_pong(benchmark::State& state)
+{
+    constexpr int rounds = 1000;
+    thread_pool pool{static_cast<std::size_t>(state.range(0))};
+    actor<Player> ping{pool}, pong{pool};
+    mail<void(int)> toPing, toPong;
+    for (auto _ : state)
+    {
+        delegate_latch done{1};
+        ping.get() = Player{&pong, &toPong, &done};
+        pong.get() = Player{&ping, &toPing, &done};
+        ping.tell<&Player::hit>(toPing, 2 * rounds - 1);
+        pool.wait(done);
+        while (!ping.idle() || !pong.idle())
+            ;
+    }
+    state.SetItemsProcessed(state.iterations() * rounds);
+    state.counters["round_trip_ns"] = benchmark::Counter(
+        static_cast<double>(state.iterations() * rounds),
+        benchmark::Counter::kIsRate | benchmark::Counter::kInvert);
+}
+} // namespace
+
+BENCHMARK(BM_actor_fan_out)->Arg(1)->Arg(2)->Arg(4)->UseRealTime();
+BENCHMARK(BM_mutex_per_object);
+BENCHMARK(BM_actor_ping_pong)->Arg(1)->Arg(2)->UseRealTime();
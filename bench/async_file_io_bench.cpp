@@ -0,0 +1,125 @@
+#include "delegate/async_file_io.hpp"
+
+#include <random>
+#include <vector>
+
+#include <fcntl.h>
+#include <stdlib.h>
+
+#include <benchmark/benchmark.h>
+
+namespace
+{
+using Completion = async_file_io::Completion;
+
+constexpr std::size_t blockSize = 4096;
+constexpr std::size_t fileBlocks = 4096; // 16 MiB.
+
+// range(0) select the file system: 0 tmpfs, 1 the disk behind /var/tmp.
+const char*
+directory(std::int64_t fs)
+{
+    return fs == 0 ? "/dev/shm" : "/var/tmp";
+}
+
+struct File
+{
+    explicit File(std::int64_t fs)
+    {
+        std::string path = std::string(directory(fs)) + "/delegate_io_XXXXXX";
+        fd = ::mkstemp(&path[0]);
+        ::unlink(path.c_str());
+        std::vector<char> block(blockSize, 'x');
+        for (std::size_t i = 0; i < fileBlocks; ++i)
+            (void)::pwrite(fd, block.data(), blockSize, i * blockSize);
+        ::fsync(fd);
+    }
+    ~File()
+    {
+        ::close(fd);
+    }
+    int fd;
+};
+
+struct Offsets
+{
+    std::uint64_t next()
+    {
+        return dist(rng) * blockSize;
+    }
+    std::mt19937 rng{7};
+    std::uniform_int_distribution<std::uint64_t> dist{0, fileBlocks - 1};
+};
+
+struct Counter
+{
+    void onDone(int res)
+    {
+        bytes += res;
+    }
+    std::int64_t bytes = 0;
+};
+
+// range(1): 0 read, 1 write.
+void
+BM_sync_io(benchmark::State& state)
+{
+    File file{state.range(0)};
+    std::vector<char> buf(blockSize, 'y');
+    Offsets offsets;
+    for (auto _ : state)
+    {
+        auto off = static_cast<off_t>(offsets.next());
+        auto res = state.range(1) == 0
+                       ? ::pread(file.fd, buf.data(), blockSize, off)
+                       : ::pwrite(file.fd, buf.data(), blockSize, off);
+        benchmark::DoNotOptimize(res);
+    }
+    state.SetItemsProcessed(state.iterations());
+    state.SetBytesProcessed(state.iterations() * blockSize);
+}
+
+/**
+ * range(1): 0 read, 1 write. range(2): queue depth, each iteration submit
+ * a batch and wait for it. range(3): 1 io_uring, 0 thread fallback.
+ * With a queue depth of 1 the time per iteration is the latency.
+ */
+void
+BM_async_io(benchmark::State& state)
+{
+    File file{state.range(0)};
+    auto depth = static_cast<std::size_t>(state.range(2));
+    std::vector<char> buf(blockSize * depth, 'y');
+    Offsets offsets;
+    Counter counter;
+    thread_pool pool{4};
+    async_file_io io{pool, depth, state.range(3) != 0};
+    if (state.range(3) != 0 &&
+        io.get_backend() != async_file_io::backend::io_uring)
+    {
+        state.SkipWithError("io_uring not available");
+        return;
+    }
+    auto done = Completion::make<&Counter::onDone>(counter);
+    for (auto _ : state)
+    {
+        for (std::size_t i = 0; i < depth; ++i)
+        {
+            char* b = buf.data() + i * blockSize;
+            if (state.range(1) == 0)
+                io.read(file.fd, b, blockSize, offsets.next(), done);
+            else
+                io.write(file.fd, b, blockSize, offsets.next(), done);
+        }
+        io.submit();
+        io.drain();
+    }
+    state.SetItemsProcessed(state.iterations() * depth);
+    state.SetBytesProcessed(counter.bytes);
+}
+} // namespace
+
+BENCHMARK(BM_sync_io)->ArgsProduct({{0, 1}, {0, 1}});
+BENCHMARK(BM_async_io)
+    ->ArgsProduct({{0, 1}, {0, 1}, {1, 8, 32}, {1, 0}})
+    ->UseRealTime();
@@ -0,0 +1,122 @@
+#include "delegate/buffer_invoke.hpp"
+
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+namespace
+{
+using Sig = void(int, double, std::uint16_t);
+using Del = delegate<Sig>;
+
+struct Handler
+{
+    void onMessage(int a, double b, std::uint16_t c)
+    {
+        sum += a + b + c;
+    }
+    double sum = 0;
+};
+
+struct Vec
+{
+    double x, y, z;
+};
+
+struct VecHandler
+{
+    void onVec(const Vec& v, int id)
+    {
+        sum += v.x + v.y + v.z + id;
+    }
+    double sum = 0;
+};
+
+constexpr std::size_t msgCount = 1024;
+
+template <typename S, typename Layout>
+std::vector<std::byte>
+makeMessages(std::size_t stride)
+{
+    std::vector<std::byte> buf(msgCount * stride);
+    for (std::size_t i = 0; i < msgCount; ++i)
+    {
+        if constexpr (std::is_same<S, Sig>::value)
+            encode_call<S, Layout>(buf.data() + i * stride, stride,
+                                   static_cast<int>(i), i * 0.5,
+                                   static_cast<std::uint16_t>(i));
+        else
+            encode_call<S, Layout>(buf.data() + i * stride, stride,
+                                   Vec{1.0 * i, 2.0, 3.0},
+                                   static_cast<int>(i));
+    }
+    return buf;
+}
+
+// Baseline: hand written decode of the packed message and a delegate call.
+void
+BM_hand_written_decode(benchmark::State& state)
+{
+    constexpr auto stride = encoded_size<Sig>();
+    auto buf = makeMessages<Sig, packed_layout>(stride);
+    Handler h;
+    auto del = Del::make<&Handler::onMessage>(h);
+    for (auto _ : state)
+    {
+        for (std::size_t i = 0; i < msgCount; ++i)
+        {
+            const std::byte* p = buf.data() + i * stride;
+            int a;
+            double b;
+            std::uint16_t c;
+            std::memcpy(&a, p, sizeof a);
+            std::memcpy(&b, p + sizeof a, sizeof b);
+            std::memcpy(&c, p + sizeof a + sizeof b, sizeof c);
+            del(a, b, c);
+        }
+    }
+    benchmark::DoNotOptimize(h.sum);
+    state.SetItemsProcessed(state.iterations() * msgCount);
+}
+
+void
+BM_invoke_from_buffer_packed(benchmark::State& state)
+{
+    constexpr auto stride = encoded_size<Sig>();
+    auto buf = makeMessages<Sig, packed_layout>(stride);
+    Handler h;
+    auto del = Del::make<&Handler::onMessage>(h);
+    for (auto _ : state)
+    {
+        for (std::size_t i = 0; i < msgCount; ++i)
+            invoke_from_buffer(del, buf.data() + i * stride, stride);
+    }
+    benchmark::DoNotOptimize(h.sum);
+    state.SetItemsProcessed(state.iterations() * msgCount);
+}
+
+template <typename Layout>
+void
+BM_invoke_from_buffer_vec(benchmark::State& state)
+{
+    using VecSig = void(const Vec&, int);
+    constexpr auto align = encoded_align<VecSig, aligned_layout>();
+    constexpr auto stride =
+        (encoded_size<VecSig, Layout>() + align - 1) / align * align;
+    auto buf = makeMessages<VecSig, Layout>(stride);
+    VecHandler h;
+    auto del = delegate<VecSig>::make<&VecHandler::onVec>(h);
+    for (auto _ : state)
+    {
+        for (std::size_t i = 0; i < msgCount; ++i)
+            invoke_from_buffer<Layout>(del, buf.data() + i * stride, stride);
+    }
+    benchmark::DoNotOptimize(h.sum);
+    state.SetItemsProcessed(state.iterations() * msgCount);
+}
+} // namespace
+
+BENCHMARK(BM_hand_written_decode);
+BENCHMARK(BM_invoke_from_buffer_packed);
+BENCHMARK_TEMPLATE(BM_invoke_from_buffer_vec, packed_layout);
+BENCHMARK_TEMPLATE(BM_invoke_from_buffer_vec, aligned_layout);
@@ -0,0 +1,126 @@
+#include "delegate/coalescer.hpp"
+
+#include <mutex>
+#include <random>
+#include <unordered_set>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+namespace
+{
+using Del = delegate<void()>;
+
+constexpr std::size_t postsPerFrame = 1024;
+
+struct Dirty
+{
+    // Some work standing in for a redraw / telemetry update.
+    void update()
+    {
+        for (int i = 0; i < 32; ++i)
+            value = value * 31 + i;
+        benchmark::DoNotOptimize(value);
+    }
+    unsigned value = 0;
+};
+
+// Posts for one frame. 'dupPercent' of the posts repeat an earlier delegate.
+std::vector<Del>
+framePosts(std::vector<Dirty>& objects, int dupPercent)
+{
+    std::size_t unique = postsPerFrame * (100 - dupPercent) / 100;
+    if (unique == 0)
+        unique = 1;
+    objects.resize(unique);
+    std::vector<Del> posts;
+    std::mt19937 rng(7);
+    for (std::size_t i = 0; i < postsPerFrame; ++i)
+    {
+        auto k = i < unique ? i : rng() % unique;
+        posts.push_back(Del::make<&Dirty::update>(objects[k]));
+    }
+    std::shuffle(posts.begin(), posts.end(), rng);
+    return posts;
+}
+
+// Baseline: call on every post.
+void
+BM_direct_call(benchmark::State& state)
+{
+    std::vector<Dirty> objects;
+    auto posts = framePosts(objects, static_cast<int>(state.range(0)));
+    for (auto _ : state)
+        for (auto& del : posts)
+            del();
+    state.SetItemsProcessed(state.iterations() * postsPerFrame);
+}
+
+// Baseline: mutex protected std::unordered_set, flushed per frame.
+void
+BM_mutex_unordered_set(benchmark::State& state)
+{
+    std::vector<Dirty> objects;
+    auto posts = framePosts(objects, static_cast<int>(state.range(0)));
+    std::mutex mutex;
+    std::unordered_set<Del, Del::Hash, Del::Equal> pending;
+    std::vector<Del> run;
+    for (auto _ : state)
+    {
+        for (auto& del : posts)
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            pending.insert(del);
+        }
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            run.assign(pending.begin(), pending.end());
+            pending.clear();
+        }
+        for (auto& del : run)
+            del();
+    }
+    state.SetItemsProcessed(state.iterations() * postsPerFrame);
+}
+
+void
+BM_coalescer(benchmark::State& state)
+{
+    std::vector<Dirty> objects;
+    auto posts = framePosts(objects, static_cast<int>(state.range(0)));
+    static coalescer<postsPerFrame> q;
+    for (auto _ : state)
+    {
+        for (auto& del : posts)
+            q.post(del);
+        q.flush();
+    }
+    state.SetItemsProcessed(state.iterations() * postsPerFrame);
+}
+
+// Posting cost only, from several threads into one coalescer.
+void
+BM_coalescer_post_mt(benchmark::State& state)
+{
+    static std::vector<Dirty> objects;
+    static std::vector<Del> posts;
+    static coalescer<postsPerFrame> q;
+    if (state.thread_index() == 0)
+        posts = framePosts(objects, 90);
+    std::size_t i = 0;
+    for (auto _ : state)
+    {
+        q.post(posts[i]);
+        i = (i + 1) % postsPerFrame;
+        if (state.thread_index() == 0 && i == 0)
+            q.flush();
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+} // namespace
+
+// Duplicate ratio in percent.
+BENCHMARK(BM_direct_call)->Arg(0)->Arg(50)->Arg(90)->Arg(99);
+BENCHMARK(BM_mutex_unordered_set)->Arg(0)->Arg(50)->Arg(90)->Arg(99);
+BENCHMARK(BM_coalescer)->Arg(0)->Arg(50)->Arg(90)->Arg(99);
+BENCHMARK(BM_coalescer_post_mt)->ThreadRange(1, 8);
@@ -0,0 +1,133 @@
+#include "delegate/command_table.hpp"
+
+#include <algorithm>
+#include <map>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+namespace
+{
+using Sig = int(int);
+using Del = delegate<Sig>;
+
+int
+handler(int x)
+{
+    return x + 1;
+}
+
+// Command names "c0000", "c0001" ... kept in static storage so the
+// constexpr table can refer to them.
+constexpr std::size_t nameLen = 5;
+
+template <std::size_t N>
+struct Names
+{
+    char text[N][nameLen + 1];
+};
+
+template <std::size_t N>
+constexpr Names<N>
+makeNames()
+{
+    Names<N> names{};
+    for (std::size_t i = 0; i < N; ++i)
+    {
+        names.text[i][0] = 'c';
+        std::size_t v = i;
+        for (std::size_t d = nameLen - 1; d > 0; --d, v /= 10)
+            names.text[i][d] = static_cast<char>('0' + v % 10);
+    }
+    return names;
+}
+
+template <std::size_t N>
+constexpr Names<N> s_names = makeNames<N>();
+
+template <std::size_t N>
+constexpr std::array<command_entry<Sig>, N>
+makeEntries()
+{
+    std::array<command_entry<Sig>, N> entries{};
+    for (std::size_t i = 0; i < N; ++i)
+        entries[i] = {std::string_view(s_names<N>.text[i], nameLen),
+                      Del::make<handler>()};
+    return entries;
+}
+
+template <std::size_t N>
+constexpr auto s_table = make_command_table(makeEntries<N>());
+
+// Lookup keys in random order.
+template <std::size_t N>
+std::vector<std::string>
+lookupKeys()
+{
+    std::vector<std::string> keys;
+    for (std::size_t i = 0; i < N; ++i)
+        keys.emplace_back(s_names<N>.text[i], nameLen);
+    std::mt19937 rng(1234);
+    std::shuffle(keys.begin(), keys.end(), rng);
+    return keys;
+}
+
+template <std::size_t N>
+void
+BM_command_table(benchmark::State& state)
+{
+    static_assert(s_table<N>.ok(), "Table build failed");
+    auto keys = lookupKeys<N>();
+    std::size_t i = 0;
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(s_table<N>.find(keys[i])(1));
+        i = (i + 1) % N;
+    }
+}
+
+template <std::size_t N>
+void
+BM_std_map(benchmark::State& state)
+{
+    std::map<std::string, Del, std::less<>> table;
+    for (const auto& e : makeEntries<N>())
+        table.emplace(std::string(e.name), e.del);
+    auto keys = lookupKeys<N>();
+    std::size_t i = 0;
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(table.find(keys[i])->second(1));
+        i = (i + 1) % N;
+    }
+}
+
+template <std::size_t N>
+void
+BM_std_unordered_map(benchmark::State& state)
+{
+    std::unordered_map<std::string, Del> table;
+    for (const auto& e : makeEntries<N>())
+        table.emplace(std::string(e.name), e.del);
+    auto keys = lookupKeys<N>();
+    std::size_t i = 0;
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(table.find(keys[i])->second(1));
+        i = (i + 1) % N;
+    }
+}
+} // namespace
+
+BENCHMARK_TEMPLATE(BM_command_table, 10);
+BENCHMARK_TEMPLATE(BM_command_table, 100);
+BENCHMARK_TEMPLATE(BM_command_table, 1000);
+BENCHMARK_TEMPLATE(BM_std_map, 10);
+BENCHMARK_TEMPLATE(BM_std_map, 100);
+BENCHMARK_TEMPLATE(BM_std_map, 1000);
+BENCHMARK_TEMPLATE(BM_std_unordered_map, 10);
+BENCHMARK_TEMPLATE(BM_std_unordered_map, 100);
+BENCHMARK_TEMPLATE(BM_std_unordered_map, 1000);
@@ -0,0 +1,101 @@
+#!/usr/bin/env python3
+"""
+Compile time benchmark of delegate.hpp.
+
+Generate a translation unit using N delegate signatures with M targets each
+(member functions, const member functions and free functions), compile it
+for each language standard, with and without DELEGATE_LEAN, and report wall
+time and peak memory of the compiler.
+
+    python3 bench/compile_time.py [--signatures N] [--targets M] [--cxx g++]
+"""
+
+import argparse
+import os
+import subprocess
+import sys
+import tempfile
+import time
+
+HERE = os.path.dirname(os.path.abspath(__file__))
+INCLUDE = os.path.join(HERE, "..", "include")
+
+
+def generate(signatures, targets, cxx17):
+    out = ['#include "delegate/delegate.hpp"', ""]
+    for s in range(signatures):
+        out.append("struct Tag%d { int v; };" % s)
+        out.append("struct Obj%d" % s)
+        out.append("{")
+        for t in range(targets):
+            if t % 2:
+                out.append("    int f%d(Tag%d a, int b) const { return a.v + b + %d; }"
+                           % (t, s, t))
+            else:
+                out.append("    int f%d(Tag%d a, int b) { return a.v - b + %d; }"
+                           % (t, s, t))
+        out.append("};")
+        out.append("inline int free%d(Tag%d a, int b) { return a.v * b; }" % (s, s))
+        out.append("int use%d(Obj%d& o)" % (s, s))
+        out.append("{")
+        out.append("    using Del = delegate<int(Tag%d, int)>;" % s)
+        out.append("    Del dels[%d];" % (targets + 1))
+        for t in range(targets):
+            if cxx17:
+                out.append("    dels[%d] = Del::make<&Obj%d::f%d>(o);" % (t, s, t))
+            else:
+                out.append("    dels[%d] = Del::make<Obj%d, &Obj%d::f%d>(o);"
+                           % (t, s, s, t))
+        out.append("    dels[%d] = Del::make<free%d>();" % (targets, s))
+        out.append("    int sum = 0;")
+        out.append("    for (auto& d : dels)")
+        out.append("        sum += d(Tag%d{1}, 2);" % s)
+        out.append("    return sum;")
+        out.append("}")
+        out.append("")
+    return "\n".join(out)
+
+
+def compile_once(cxx, std, lean, source):
+    cmd = [cxx, "-std=" + std, "-O1", "-c", "-o", os.devnull, "-I", INCLUDE]
+    if lean:
+        cmd.append("-DDELEGATE_LEAN")
+    cmd.append(source)
+    start = time.monotonic()
+    proc = subprocess.Popen(cmd)
+    _, status, usage = os.wait4(proc.pid, 0)
+    elapsed = time.monotonic() - start
+    if status != 0:
+        sys.exit("Compilation failed: " + " ".join(cmd))
+    # ru_maxrss is in KiB on Linux.
+    return elapsed, usage.ru_maxrss / 1024.0
+
+
+def main():
+    parser = argparse.ArgumentParser()
+    parser.add_argument("--signatures", type=int, default=200)
+    parser.add_argument("--targets", type=int, default=8)
+    parser.add_argument("--cxx", default="g++")
+    parser.add_argument("--repeat", type=int, default=3)
+    args = parser.parse_args()
+
+    print("%d signatures x %d targets, %s, best of %d"
+          % (args.signatures, args.targets, args.cxx, args.repeat))
+    print("%-8s %-6s %10s %10s" % ("std", "mode", "time (s)", "mem (MiB)"))
+    with tempfile.TemporaryDirectory() as tmp:
+        for std in ("c++11", "c++14", "c++17"):
+            source = os.path.join(tmp, "gen_%s.cpp" % std.replace("+", "p"))
+            with open(source, "w") as f:
+                f.write(generate(args.signatures, args.targets,
+                                 std == "c++17"))
+            for lean in (False, True):
+                runs = [compile_once(args.cxx, std, lean, source)
+                        for _ in range(args.repeat)]
+                best = min(r[0] for r in runs)
+                mem = min(r[1] for r in runs)
+                print("%-8s %-6s %10.2f %10.1f"
+                      % (std, "lean" if lean else "full", best, mem))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,105 @@
+#include "delegate/deferred_log.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+#include <fcntl.h>
+
+#include <benchmark/benchmark.h>
+
+namespace
+{
+using Clock = std::chrono::steady_clock;
+
+constexpr int samples = 200000;
+
+void
+orderLine(log_writer& w, int id, double price, const char* side)
+{
+    w << "order " << id << ' ' << side << " at " << price << '\n';
+}
+
+// Time each call of 'fn', report the percentiles as counters.
+template <typename Fn>
+void
+measure(benchmark::State& state, Fn fn)
+{
+    std::vector<std::int64_t> latencies;
+    latencies.reserve(samples);
+    int i = 0;
+    for (auto _ : state)
+    {
+        auto start = Clock::now();
+        fn(i++);
+        auto end = Clock::now();
+        latencies.push_back(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(end - start)
+                .count());
+    }
+    std::sort(latencies.begin(), latencies.end());
+    auto at = [&](double q) {
+        return static_cast<double>(
+            latencies[static_cast<std::size_t>(q * (latencies.size() - 1))]);
+    };
+    state.counters["p50_ns"] = at(0.5);
+    state.counters["p99_ns"] = at(0.99);
+    state.counters["p999_ns"] = at(0.999);
+    state.SetItemsProcessed(state.iterations());
+}
+
+struct DevNull
+{
+    DevNull() : fd(::open("/dev/null", O_WRONLY)) {}
+    ~DevNull()
+    {
+        ::close(fd);
+    }
+    int fd;
+};
+
+void
+BM_deferred_log(benchmark::State& state)
+{
+    DevNull null;
+    fd_sink sink{null.fd};
+    deferred_logger logger{log_writer::Sink::make<&fd_sink::write>(sink), 4,
+                           1 << 20};
+    measure(state, [&](int i) {
+        logger.log<&orderLine>(i, 10.25 + i, "buy");
+    });
+    logger.flush();
+    state.counters["dropped"] = static_cast<double>(logger.dropped());
+}
+
+// Baseline: same formatter run on the hot path, one write per line.
+void
+BM_sync_log_writer(benchmark::State& state)
+{
+    DevNull null;
+    fd_sink sink{null.fd};
+    log_writer w{log_writer::Sink::make<&fd_sink::write>(sink)};
+    measure(state, [&](int i) {
+        orderLine(w, i, 10.25 + i, "buy");
+        w.flush();
+    });
+}
+
+// Baseline: snprintf and a write per line.
+void
+BM_sync_snprintf(benchmark::State& state)
+{
+    DevNull null;
+    measure(state, [&](int i) {
+        char line[128];
+        int n = std::snprintf(line, sizeof(line), "order %d %s at %g\n", i,
+                              "buy", 10.25 + i);
+        (void)::write(null.fd, line, static_cast<std::size_t>(n));
+    });
+}
+} // namespace
+
+BENCHMARK(BM_deferred_log)->Iterations(samples);
+BENCHMARK(BM_sync_log_writer)->Iterations(samples);
+BENCHMARK(BM_sync_snprintf)->Iterations(samples);
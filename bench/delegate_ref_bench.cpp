@@ -0,0 +1,132 @@
+#include "delegate/delegate.hpp"
+
+#include <functional>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+namespace
+{
+struct Connection
+{
+    int id;
+    int bytes;
+};
+
+std::vector<Connection>
+makeConnections()
+{
+    std::vector<Connection> conns(64);
+    for (int i = 0; i < 64; ++i)
+        conns[i] = Connection{i, i * 3};
+    return conns;
+}
+
+// The three parameter styles of the same API, kept out of line as a library
+// function would be.
+__attribute__((noinline)) void
+forEachRef(const std::vector<Connection>& conns,
+           delegate_ref<void(const Connection&)> cb)
+{
+    for (auto& c : conns)
+        cb(c);
+}
+
+__attribute__((noinline)) void
+forEachFunction(const std::vector<Connection>& conns,
+                std::function<void(const Connection&)> cb)
+{
+    for (auto& c : conns)
+        cb(c);
+}
+
+template <typename F>
+__attribute__((noinline)) void
+forEachTemplate(const std::vector<Connection>& conns, F&& cb)
+{
+    for (auto& c : conns)
+        cb(c);
+}
+
+// Capture large enough to defeat the std::function small buffer.
+struct Totals
+{
+    long bytes = 0;
+    long ids = 0;
+};
+
+void
+BM_delegate_ref_param(benchmark::State& state)
+{
+    auto conns = makeConnections();
+    Totals t;
+    long extra = 1;
+    for (auto _ : state)
+    {
+        forEachRef(conns, [&t, extra](const Connection& c) {
+            t.bytes += c.bytes + extra;
+            t.ids += c.id;
+        });
+        benchmark::DoNotOptimize(t);
+    }
+    state.SetItemsProcessed(state.iterations() * conns.size());
+}
+
+void
+BM_std_function_param(benchmark::State& state)
+{
+    auto conns = makeConnections();
+    Totals t;
+    long extra = 1, extra2 = 2, extra3 = 3;
+    for (auto _ : state)
+    {
+        forEachFunction(conns,
+                        [&t, extra, extra2, extra3](const Connection& c) {
+                            t.bytes += c.bytes + extra + extra2 + extra3;
+                            t.ids += c.id;
+                        });
+        benchmark::DoNotOptimize(t);
+    }
+    state.SetItemsProcessed(state.iterations() * conns.size());
+}
+
+// Same capture as above, to compare the std::function allocation.
+void
+BM_delegate_ref_param_large_capture(benchmark::State& state)
+{
+    auto conns = makeConnections();
+    Totals t;
+    long extra = 1, extra2 = 2, extra3 = 3;
+    for (auto _ : state)
+    {
+        forEachRef(conns, [&t, extra, extra2, extra3](const Connection& c) {
+            t.bytes += c.bytes + extra + extra2 + extra3;
+            t.ids += c.id;
+        });
+        benchmark::DoNotOptimize(t);
+    }
+    state.SetItemsProcessed(state.iterations() * conns.size());
+}
+
+void
+BM_template_param(benchmark::State& state)
+{
+    auto conns = makeConnections();
+    Totals t;
+    long extra = 1;
+    for (auto _ : state)
+    {
+        forEachTemplate(conns, [&t, extra](const Connection& c) {
+            t.bytes += c.bytes + extra;
+            t.ids += c.id;
+        });
+        benchmark::DoNotOptimize(t);
+    }
+    state.SetItemsProcessed(state.iterations() * conns.size());
+}
+} // namespace
+
+BENCHMARK(BM_delegate_ref_param);
+BENCHMARK(BM_delegate_ref_param_large_capture);
+BENCHMARK(BM_std_function_param);
+BENCHMARK(BM_template_param);
@@ -0,0 +1,142 @@
+#include "delegate/event_bus.hpp"
+
+#include <typeindex>
+#include <unordered_map>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+namespace
+{
+struct Tick
+{
+    int n;
+};
+struct Quote
+{
+    double price;
+};
+struct Trade
+{
+    double price;
+    int size;
+};
+
+using Events = event_list<Tick, Quote, Trade>;
+
+struct Handler
+{
+    void onTick(const Tick& e) const
+    {
+        benchmark::DoNotOptimize(e.n + id);
+    }
+    void onTrade(const Trade& e) const
+    {
+        benchmark::DoNotOptimize(e.size + id);
+    }
+    int id = 0;
+};
+
+// Type erased event.
+struct EventRef
+{
+    const void* ptr;
+};
+
+// Baseline: subscribers found by type_index, events passed type erased.
+class map_bus
+{
+  public:
+    using Del = delegate<void(EventRef)>;
+
+    template <typename E>
+    void subscribe(Del del)
+    {
+        m_subs[std::type_index(typeid(E))].push_back(del);
+    }
+
+    template <typename E>
+    void publish(const E& event) const
+    {
+        auto it = m_subs.find(std::type_index(typeid(E)));
+        if (it == m_subs.end())
+            return;
+        for (auto& d : it->second)
+            d(EventRef{&event});
+    }
+
+  private:
+    std::unordered_map<std::type_index, std::vector<Del>> m_subs;
+};
+
+template <typename E, auto mFkn>
+void
+erasedCall(const Handler& h, EventRef e)
+{
+    (h.*mFkn)(*static_cast<const E*>(e.ptr));
+}
+
+void
+BM_event_bus_publish(benchmark::State& state)
+{
+    std::vector<Handler> handlers(state.range(0));
+    event_bus<Events, 64> bus;
+    for (auto& h : handlers)
+    {
+        bus.subscribe<Tick>(
+            delegate<void(const Tick&)>::make<&Handler::onTick>(h));
+        bus.subscribe<Trade>(
+            delegate<void(const Trade&)>::make<&Handler::onTrade>(h));
+    }
+    int n = 0;
+    for (auto _ : state)
+    {
+        bus.publish(Tick{++n});
+        bus.publish(Trade{1.5, n});
+    }
+    state.SetItemsProcessed(state.iterations() * 2);
+}
+
+void
+BM_type_index_map_publish(benchmark::State& state)
+{
+    using Del = map_bus::Del;
+    std::vector<Handler> handlers(state.range(0));
+    map_bus bus;
+    for (auto& h : handlers)
+    {
+        bus.subscribe<Tick>(
+            Del::make<Handler, erasedCall<Tick, &Handler::onTick>>(h));
+        bus.subscribe<Trade>(
+            Del::make<Handler, erasedCall<Trade, &Handler::onTrade>>(h));
+    }
+    int n = 0;
+    for (auto _ : state)
+    {
+        bus.publish(Tick{++n});
+        bus.publish(Trade{1.5, n});
+    }
+    state.SetItemsProcessed(state.iterations() * 2);
+}
+
+// Same thread, to measure the queue without waiting on another one.
+void
+BM_event_bus_post_drain(benchmark::State& state)
+{
+    Handler h;
+    event_bus<Events, 64, 256> bus;
+    bus.subscribe<Tick>(delegate<void(const Tick&)>::make<&Handler::onTick>(h));
+    int n = 0;
+    for (auto _ : state)
+    {
+        for (int i = 0; i < 64; ++i)
+            bus.post(Tick{++n});
+        benchmark::DoNotOptimize(bus.drain());
+    }
+    state.SetItemsProcessed(state.iterations() * 64);
+}
+} // namespace
+
+BENCHMARK(BM_event_bus_publish)->Arg(1)->Arg(8);
+BENCHMARK(BM_type_index_map_publish)->Arg(1)->Arg(8);
+BENCHMARK(BM_event_bus_post_drain);
@@ -0,0 +1,121 @@
+#include "delegate/flat_set.hpp"
+
+#include <algorithm>
+#include <random>
+#include <set>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+namespace
+{
+struct Counter
+{
+    void add(int x)
+    {
+        sum += x;
+    }
+    int sum = 0;
+};
+
+using Del = delegate<void(int)>;
+
+// Delegates to 'n' objects, in random order.
+std::vector<Del>
+makeDels(std::vector<Counter>& counters)
+{
+    std::vector<Del> dels;
+    for (auto& c : counters)
+        dels.push_back(Del::make<&Counter::add>(c));
+    std::shuffle(dels.begin(), dels.end(), std::mt19937{42});
+    return dels;
+}
+
+void
+BM_flat_set_find(benchmark::State& state)
+{
+    std::vector<Counter> counters(static_cast<std::size_t>(state.range(0)));
+    auto dels = makeDels(counters);
+    delegate_flat_set<void(int)> set;
+    set.insert_range(dels.begin(), dels.end());
+    std::size_t i = 0;
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(set.find(dels[i]));
+        i = i + 1 == dels.size() ? 0 : i + 1;
+    }
+}
+
+void
+BM_std_set_find(benchmark::State& state)
+{
+    std::vector<Counter> counters(static_cast<std::size_t>(state.range(0)));
+    auto dels = makeDels(counters);
+    std::set<Del, Del::Less> set(dels.begin(), dels.end());
+    std::size_t i = 0;
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(set.find(dels[i]));
+        i = i + 1 == dels.size() ? 0 : i + 1;
+    }
+}
+
+void
+BM_flat_set_iterate(benchmark::State& state)
+{
+    std::vector<Counter> counters(static_cast<std::size_t>(state.range(0)));
+    auto dels = makeDels(counters);
+    delegate_flat_set<void(int)> set;
+    set.insert_range(dels.begin(), dels.end());
+    for (auto _ : state)
+        for (auto& d : set)
+            d(1);
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void
+BM_std_set_iterate(benchmark::State& state)
+{
+    std::vector<Counter> counters(static_cast<std::size_t>(state.range(0)));
+    auto dels = makeDels(counters);
+    std::set<Del, Del::Less> set(dels.begin(), dels.end());
+    for (auto _ : state)
+        for (auto& d : set)
+            d(1);
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void
+BM_flat_set_build(benchmark::State& state)
+{
+    std::vector<Counter> counters(static_cast<std::size_t>(state.range(0)));
+    auto dels = makeDels(counters);
+    for (auto _ : state)
+    {
+        delegate_flat_set<void(int)> set;
+        set.insert_range(dels.begin(), dels.end());
+        benchmark::DoNotOptimize(set.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void
+BM_std_set_build(benchmark::State& state)
+{
+    std::vector<Counter> counters(static_cast<std::size_t>(state.range(0)));
+    auto dels = makeDels(counters);
+    for (auto _ : state)
+    {
+        std::set<Del, Del::Less> set(dels.begin(), dels.end());
+        benchmark::DoNotOptimize(&set);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+} // namespace
+
+BENCHMARK(BM_flat_set_find)->Range(16, 64 * 1024);
+BENCHMARK(BM_std_set_find)->Range(16, 64 * 1024);
+BENCHMARK(BM_flat_set_iterate)->Range(16, 64 * 1024);
+BENCHMARK(BM_std_set_iterate)->Range(16, 64 * 1024);
+BENCHMARK(BM_flat_set_build)->Range(16, 64 * 1024);
+BENCHMARK(BM_std_set_build)->Range(16, 64 * 1024);
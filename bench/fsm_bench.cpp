@@ -0,0 +1,148 @@
+#include "delegate/fsm.hpp"
+
+#include <benchmark/benchmark.h>
+
+namespace
+{
+enum class State
+{
+    Idle,
+    Connecting,
+    Open
+};
+
+enum class Event
+{
+    Connect,
+    Ack,
+    Data,
+    Close
+};
+
+struct Conn
+{
+    void sendSyn(int x)
+    {
+        benchmark::DoNotOptimize(sent += x);
+    }
+    void onAck(int x)
+    {
+        benchmark::DoNotOptimize(acked += x);
+    }
+    bool ackValid(int seq) const
+    {
+        return seq == 1;
+    }
+    void onData(int bytes)
+    {
+        benchmark::DoNotOptimize(received += bytes);
+    }
+    void onClose(int)
+    {
+        benchmark::DoNotOptimize(++closed);
+    }
+    int sent = 0;
+    int acked = 0;
+    int received = 0;
+    int closed = 0;
+};
+
+using ConnFsm =
+    fsm<Conn, void(int),
+        transition<State::Idle, Event::Connect, State::Connecting,
+                   &Conn::sendSyn>,
+        transition<State::Connecting, Event::Ack, State::Open, &Conn::onAck,
+                   &Conn::ackValid>,
+        transition<State::Open, Event::Data, State::Open, &Conn::onData>,
+        transition<State::Open, Event::Close, State::Idle, &Conn::onClose>,
+        transition<State::Connecting, Event::Close, State::Idle>>;
+
+// Same machine written by hand.
+class SwitchFsm
+{
+  public:
+    explicit SwitchFsm(Conn& conn) : m_conn(conn) {}
+
+    bool dispatch(Event event, int arg)
+    {
+        switch (m_state)
+        {
+        case State::Idle:
+            if (event == Event::Connect)
+            {
+                m_state = State::Connecting;
+                m_conn.sendSyn(arg);
+                return true;
+            }
+            return false;
+        case State::Connecting:
+            switch (event)
+            {
+            case Event::Ack:
+                if (!m_conn.ackValid(arg))
+                    return false;
+                m_state = State::Open;
+                m_conn.onAck(arg);
+                return true;
+            case Event::Close:
+                m_state = State::Idle;
+                return true;
+            default:
+                return false;
+            }
+        case State::Open:
+            switch (event)
+            {
+            case Event::Data:
+                m_conn.onData(arg);
+                return true;
+            case Event::Close:
+                m_state = State::Idle;
+                m_conn.onClose(arg);
+                return true;
+            default:
+                return false;
+            }
+        }
+        return false;
+    }
+
+  private:
+    Conn& m_conn;
+    State m_state = State::Idle;
+};
+
+// One connection: connect, ack, 6 data packets, close.
+constexpr Event script[] = {Event::Connect, Event::Ack,  Event::Data,
+                            Event::Data,    Event::Data, Event::Data,
+                            Event::Data,    Event::Data, Event::Close};
+
+template <typename Machine>
+void
+run(benchmark::State& state, Machine& machine)
+{
+    for (auto _ : state)
+        for (auto e : script)
+            benchmark::DoNotOptimize(machine.dispatch(e, 1));
+    state.SetItemsProcessed(state.iterations() * std::size(script));
+}
+
+void
+BM_fsm_dispatch(benchmark::State& state)
+{
+    Conn conn;
+    ConnFsm machine{conn, State::Idle};
+    run(state, machine);
+}
+
+void
+BM_switch_dispatch(benchmark::State& state)
+{
+    Conn conn;
+    SwitchFsm machine{conn};
+    run(state, machine);
+}
+} // namespace
+
+BENCHMARK(BM_fsm_dispatch);
+BENCHMARK(BM_switch_dispatch);
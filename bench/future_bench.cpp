@@ -0,0 +1,93 @@
+#include "delegate/future.hpp"
+
+#include <future>
+
+#include <benchmark/benchmark.h>
+
+namespace
+{
+struct Sink
+{
+    void onValue(int&& v)
+    {
+        benchmark::DoNotOptimize(sum += v);
+    }
+    int sum = 0;
+};
+
+int
+addOne(int&& v)
+{
+    return v + 1;
+}
+
+// Baseline: the producer calls the consumer callback directly.
+void
+BM_raw_callback(benchmark::State& state)
+{
+    Sink sink;
+    auto cb = delegate<void(int&&)>::make<&Sink::onValue>(sink);
+    int n = 0;
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(cb);
+        cb(int{++n});
+    }
+}
+
+void
+BM_std_future(benchmark::State& state)
+{
+    Sink sink;
+    int n = 0;
+    for (auto _ : state)
+    {
+        std::promise<int> p;
+        auto f = p.get_future();
+        p.set_value(++n);
+        sink.onValue(f.get());
+    }
+}
+
+void
+BM_delegate_future(benchmark::State& state)
+{
+    Sink sink;
+    future_state<int> fs;
+    int n = 0;
+    for (auto _ : state)
+    {
+        fs.reset();
+        promise<int> p{fs};
+        p.get_future().then(
+            delegate<void(int&&)>::make<&Sink::onValue>(sink));
+        p.set_value(++n);
+    }
+}
+
+// Two transformations before the final continuation.
+void
+BM_delegate_future_chain(benchmark::State& state)
+{
+    Sink sink;
+    future_state<int> fs;
+    then_stage<int, int> a{delegate<int(int&&)>::make<addOne>()};
+    then_stage<int, int> b{delegate<int(int&&)>::make<addOne>()};
+    int n = 0;
+    for (auto _ : state)
+    {
+        fs.reset();
+        a.reset();
+        b.reset();
+        promise<int> p{fs};
+        p.get_future().then(a).then(b).then(
+            delegate<void(int&&)>::make<&Sink::onValue>(sink));
+        p.set_value(++n);
+    }
+}
+} // namespace
+
+BENCHMARK(BM_raw_callback);
+BENCHMARK(BM_std_future);
+BENCHMARK(BM_delegate_future);
+BENCHMARK(BM_delegate_future_chain);
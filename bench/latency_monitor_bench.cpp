@@ -0,0 +1,66 @@
+#include "delegate/latency_monitor.hpp"
+
+#include <benchmark/benchmark.h>
+
+namespace
+{
+using Monitor = latency_monitor<int(int)>;
+using Del = Monitor::Del;
+
+struct Work
+{
+    int run(int x)
+    {
+        benchmark::DoNotOptimize(x += id);
+        return x;
+    }
+    int id = 1;
+};
+
+void
+BM_direct_call(benchmark::State& state)
+{
+    Work w;
+    auto del = Del::make<&Work::run>(w);
+    benchmark::DoNotOptimize(del);
+    for (auto _ : state)
+        benchmark::DoNotOptimize(del(1));
+}
+
+void
+BM_monitored_call(benchmark::State& state)
+{
+    Work w;
+    Monitor monitor;
+    auto del = Del::make<&Work::run>(w);
+    monitor.track(del, std::chrono::milliseconds(1));
+    for (auto _ : state)
+        benchmark::DoNotOptimize(monitor.call(del, 1));
+}
+
+// Baseline for the clock reads alone.
+void
+BM_two_steady_clock_reads(benchmark::State& state)
+{
+    for (auto _ : state)
+    {
+        auto start = std::chrono::steady_clock::now();
+        benchmark::DoNotOptimize(std::chrono::steady_clock::now() - start);
+    }
+}
+
+void
+BM_histogram_percentile(benchmark::State& state)
+{
+    latency_histogram h;
+    for (std::uint64_t v = 1; v < 100000; v += 7)
+        h.record(v);
+    for (auto _ : state)
+        benchmark::DoNotOptimize(h.percentile(0.99));
+}
+} // namespace
+
+BENCHMARK(BM_direct_call);
+BENCHMARK(BM_monitored_call);
+BENCHMARK(BM_two_steady_clock_reads);
+BENCHMARK(BM_histogram_percentile);
@@ -0,0 +1,62 @@
+#include "delegate/lazy.hpp"
+
+#include <mutex>
+
+#include <benchmark/benchmark.h>
+
+namespace
+{
+int
+compute()
+{
+    return 42;
+}
+
+// Steady state read after initialization.
+void
+BM_lazy_get(benchmark::State& state)
+{
+    static lazy<int> value{delegate<int()>::make<compute>()};
+    value.get();
+    for (auto _ : state)
+        benchmark::DoNotOptimize(value.get());
+}
+
+void
+BM_local_lazy_get(benchmark::State& state)
+{
+    static thread_local local_lazy<int> value{
+        delegate<int()>::make<compute>()};
+    value.get();
+    for (auto _ : state)
+        benchmark::DoNotOptimize(value.get());
+}
+
+void
+BM_call_once_get(benchmark::State& state)
+{
+    static std::once_flag flag;
+    static int value = 0;
+    for (auto _ : state)
+    {
+        std::call_once(flag, [] { value = compute(); });
+        benchmark::DoNotOptimize(value);
+    }
+}
+
+// Function local static (compiler generated guard) for reference.
+void
+BM_magic_static_get(benchmark::State& state)
+{
+    for (auto _ : state)
+    {
+        static int value = compute();
+        benchmark::DoNotOptimize(value);
+    }
+}
+} // namespace
+
+BENCHMARK(BM_lazy_get)->ThreadRange(1, 8);
+BENCHMARK(BM_local_lazy_get)->ThreadRange(1, 8);
+BENCHMARK(BM_call_once_get)->ThreadRange(1, 8);
+BENCHMARK(BM_magic_static_get)->ThreadRange(1, 8);
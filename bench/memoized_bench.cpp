@@ -0,0 +1,88 @@
+#include "delegate/memoized.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+namespace
+{
+using Sig = std::uint32_t(std::uint32_t);
+using Del = delegate<Sig>;
+
+// Stand in for an expensive pure lookup.
+std::uint32_t
+expensive(std::uint32_t key)
+{
+    std::uint32_t h = key;
+    for (int i = 0; i < 64; ++i)
+        h = h * 2654435761u + (h >> 13);
+    return h;
+}
+
+constexpr std::uint32_t keySpace = 100000;
+constexpr std::size_t sampleCount = 1 << 16;
+
+// Keys drawn from a Zipf distribution with exponent 's' (in hundredths).
+std::vector<std::uint32_t>
+zipfKeys(int s)
+{
+    std::vector<double> cdf(keySpace);
+    double sum = 0;
+    for (std::uint32_t k = 0; k < keySpace; ++k)
+    {
+        sum += 1.0 / std::pow(k + 1.0, s / 100.0);
+        cdf[k] = sum;
+    }
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<double> uni(0, sum);
+    std::vector<std::uint32_t> keys(sampleCount);
+    for (auto& key : keys)
+    {
+        auto it = std::lower_bound(cdf.begin(), cdf.end(), uni(rng));
+        auto k = it - cdf.begin();
+        // Scatter ranks over the key space.
+        key = static_cast<std::uint32_t>(k) * 2654435761u;
+    }
+    return keys;
+}
+
+void
+BM_direct(benchmark::State& state)
+{
+    auto keys = zipfKeys(static_cast<int>(state.range(0)));
+    Del del = Del::make<expensive>();
+    std::size_t i = 0;
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(del(keys[i]));
+        i = (i + 1) % sampleCount;
+    }
+}
+
+template <std::size_t N>
+void
+BM_memoized(benchmark::State& state)
+{
+    auto keys = zipfKeys(static_cast<int>(state.range(0)));
+    static memoized<Sig, N> cache;
+    cache.set(Del::make<expensive>());
+    cache.reset_stats();
+    Del del = cache.get_delegate();
+    std::size_t i = 0;
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(del(keys[i]));
+        i = (i + 1) % sampleCount;
+    }
+    state.counters["hit_rate"] =
+        double(cache.hits()) / double(cache.hits() + cache.misses());
+}
+} // namespace
+
+// Zipf exponent 0.8, 0.99 and 1.2.
+BENCHMARK(BM_direct)->Arg(99);
+BENCHMARK_TEMPLATE(BM_memoized, 256)->Arg(80)->Arg(99)->Arg(120);
+BENCHMARK_TEMPLATE(BM_memoized, 4096)->Arg(80)->Arg(99)->Arg(120);
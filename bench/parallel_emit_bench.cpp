@@ -0,0 +1,84 @@
+#include "delegate/parallel_emit.hpp"
+
+#include <cmath>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+namespace
+{
+constexpr std::size_t subscriberCount = 256;
+
+struct Frame
+{
+    std::vector<float> samples;
+};
+
+// Roughly 10us of arithmetic per call.
+struct Subscriber
+{
+    void onFrame(const Frame& frame)
+    {
+        float acc = 0;
+        for (int pass = 0; pass < 16; ++pass)
+            for (float s : frame.samples)
+                acc += std::sqrt(s + static_cast<float>(pass));
+        result = acc;
+    }
+    float result = 0;
+};
+
+using Del = delegate<void(const Frame&)>;
+
+struct Fixture
+{
+    Fixture() : subs(subscriberCount)
+    {
+        frame.samples.assign(256, 1.5f);
+        for (auto& s : subs)
+            dels.push_back(Del::make<&Subscriber::onFrame>(s));
+    }
+    Frame frame;
+    std::vector<Subscriber> subs;
+    std::vector<Del> dels;
+};
+
+void
+BM_emit_sequential(benchmark::State& state)
+{
+    Fixture f;
+    for (auto _ : state)
+        emit_sequential(f.dels.data(), f.dels.size(), f.frame);
+    state.SetItemsProcessed(state.iterations() * subscriberCount);
+}
+
+// Pool of 'range(0)' workers. The calling thread run one chunk too.
+void
+BM_emit_parallel(benchmark::State& state)
+{
+    Fixture f;
+    thread_pool pool{static_cast<std::size_t>(state.range(0))};
+    for (auto _ : state)
+        emit_parallel(pool, f.dels.data(), f.dels.size(), f.frame);
+    state.SetItemsProcessed(state.iterations() * subscriberCount);
+    state.counters["threads"] = static_cast<double>(pool.size() + 1);
+}
+
+// Light subscribers under the threshold: the hand off must not be paid.
+void
+BM_emit_parallel_below_threshold(benchmark::State& state)
+{
+    Fixture f;
+    thread_pool pool{4};
+    for (auto _ : state)
+        emit_parallel(pool, f.dels.data(), 8, f.frame);
+    state.SetItemsProcessed(state.iterations() * 8);
+}
+} // namespace
+
+BENCHMARK(BM_emit_sequential)->UseRealTime();
+BENCHMARK(BM_emit_parallel)
+    ->RangeMultiplier(2)
+    ->Range(1, 64)
+    ->UseRealTime();
+BENCHMARK(BM_emit_parallel_below_threshold)->UseRealTime();
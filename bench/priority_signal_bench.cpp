@@ -0,0 +1,93 @@
+#include "delegate/priority_signal.hpp"
+
+#include <functional>
+#include <map>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+namespace
+{
+using Sig = bool(int);
+using Del = delegate<Sig>;
+
+constexpr std::size_t handlerCount = 64;
+
+struct Handler
+{
+    bool onEvent(int ev)
+    {
+        ++seen;
+        return ev == id;
+    }
+    int id;
+    int seen = 0;
+};
+
+std::vector<Handler>
+makeHandlers()
+{
+    std::vector<Handler> handlers(handlerCount);
+    for (std::size_t i = 0; i < handlerCount; ++i)
+        handlers[i].id = static_cast<int>(i);
+    return handlers;
+}
+
+// Event consumed by the handler at depth 'range(0)'. 64 means never consumed.
+void
+BM_priority_signal_emit(benchmark::State& state)
+{
+    auto handlers = makeHandlers();
+    priority_signal<Sig, handlerCount> sig;
+    for (std::size_t i = 0; i < handlerCount; ++i)
+        sig.connect(Del::make<&Handler::onEvent>(handlers[i]),
+                    -static_cast<int>(i));
+    int ev = static_cast<int>(state.range(0));
+    for (auto _ : state)
+        benchmark::DoNotOptimize(sig.emit(ev));
+}
+
+// Baseline: std::multimap of std::function ordered on priority.
+void
+BM_multimap_function_emit(benchmark::State& state)
+{
+    auto handlers = makeHandlers();
+    std::multimap<int, std::function<bool(int)>, std::greater<int>> sig;
+    for (std::size_t i = 0; i < handlerCount; ++i)
+    {
+        Handler* h = &handlers[i];
+        sig.emplace(-static_cast<int>(i),
+                    [h](int ev) { return h->onEvent(ev); });
+    }
+    int ev = static_cast<int>(state.range(0));
+    for (auto _ : state)
+    {
+        bool consumed = false;
+        for (auto& entry : sig)
+            if ((consumed = entry.second(ev)))
+                break;
+        benchmark::DoNotOptimize(consumed);
+    }
+}
+
+// Connect and disconnect a subscriber in the middle of a full signal.
+void
+BM_priority_signal_connect_disconnect(benchmark::State& state)
+{
+    auto handlers = makeHandlers();
+    priority_signal<Sig, handlerCount + 1> sig;
+    for (std::size_t i = 0; i < handlerCount; ++i)
+        sig.connect(Del::make<&Handler::onEvent>(handlers[i]),
+                    -static_cast<int>(i));
+    Handler extra{-1};
+    for (auto _ : state)
+    {
+        auto h = sig.connect(Del::make<&Handler::onEvent>(extra), -32);
+        sig.disconnect(h);
+    }
+}
+} // namespace
+
+BENCHMARK(BM_priority_signal_emit)->Arg(0)->Arg(4)->Arg(16)->Arg(64);
+BENCHMARK(BM_multimap_function_emit)->Arg(0)->Arg(4)->Arg(16)->Arg(64);
+BENCHMARK(BM_priority_signal_connect_disconnect);
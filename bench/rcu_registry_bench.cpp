@@ -0,0 +1,86 @@
+#include "delegate/rcu_registry.hpp"
+
+#include <mutex>
+#include <shared_mutex>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+namespace
+{
+using Registry = rcu_registry<void(int), 16>;
+using Del = Registry::Del;
+
+constexpr std::size_t handlerCount = 8;
+
+// No state written, handlers are shared by all benchmark threads.
+struct Handler
+{
+    void onPacket(int x) const
+    {
+        benchmark::DoNotOptimize(x + id);
+    }
+    int id = 0;
+};
+
+Registry g_registry;
+std::vector<Del> g_dels;
+std::shared_mutex g_sharedMutex;
+std::mutex g_mutex;
+Handler g_handlers[handlerCount];
+
+void
+setup(const benchmark::State& state)
+{
+    if (state.thread_index() != 0)
+        return;
+    static bool done = false;
+    if (done)
+        return;
+    done = true;
+    for (auto& h : g_handlers)
+    {
+        g_registry.add(Del::make<&Handler::onPacket>(h));
+        g_dels.push_back(Del::make<&Handler::onPacket>(h));
+    }
+}
+
+void
+BM_rcu_registry_emit(benchmark::State& state)
+{
+    setup(state);
+    auto reader = g_registry.make_reader();
+    for (auto _ : state)
+        g_registry.emit(reader, 1);
+}
+
+// Baseline: vector of delegates under a shared_mutex read lock.
+void
+BM_shared_mutex_emit(benchmark::State& state)
+{
+    setup(state);
+    for (auto _ : state)
+    {
+        std::shared_lock<std::shared_mutex> lock(g_sharedMutex);
+        for (auto& d : g_dels)
+            d(1);
+    }
+}
+
+// Baseline: vector of delegates under a mutex.
+void
+BM_mutex_emit(benchmark::State& state)
+{
+    setup(state);
+    for (auto _ : state)
+    {
+        std::lock_guard<std::mutex> lock(g_mutex);
+        for (auto& d : g_dels)
+            d(1);
+    }
+}
+} // namespace
+
+BENCHMARK(BM_rcu_registry_emit)->Threads(1)->Threads(2)->Threads(4);
+BENCHMARK(BM_shared_mutex_emit)->Threads(1)->Threads(2)->Threads(4);
+BENCHMARK(BM_mutex_emit)->Threads(1)->Threads(2)->Threads(4);
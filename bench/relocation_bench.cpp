@@ -0,0 +1,53 @@
+#include "delegate/relocation.hpp"
+
+#include <cstdint>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+namespace
+{
+struct Obj
+{
+    void onEvent(int x)
+    {
+        value += x;
+    }
+    int value = 0;
+};
+
+using Del = delegate<void(int)>;
+
+// Compact a pool where every other object is moved, 'range(0)' delegates
+// per object.
+void
+BM_relocate_pool(benchmark::State& state)
+{
+    constexpr std::size_t objects = 4096;
+    std::vector<Obj> from(objects);
+    std::vector<Obj> to(objects);
+    std::vector<Del> dels;
+    for (std::int64_t i = 0; i < state.range(0); ++i)
+        for (auto& o : from)
+            dels.push_back(Del::make<Obj, &Obj::onEvent>(o));
+
+    std::vector<relocation> there;
+    std::vector<relocation> back;
+    for (std::size_t i = 0; i < objects; i += 2)
+    {
+        there.push_back({&from[i], &to[i / 2], sizeof(Obj)});
+        back.push_back({&to[i / 2], &from[i], sizeof(Obj)});
+    }
+
+    relocation_registry registry;
+    registry.add(dels);
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(registry.relocate(there.data(), there.size()));
+        benchmark::DoNotOptimize(registry.relocate(back.data(), back.size()));
+    }
+    state.SetItemsProcessed(state.iterations() * dels.size() * 2);
+}
+} // namespace
+
+BENCHMARK(BM_relocate_pool)->Arg(1)->Arg(4);
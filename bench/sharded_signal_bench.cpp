@@ -0,0 +1,133 @@
+#include "delegate/sharded_signal.hpp"
+
+#include <algorithm>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+namespace
+{
+using Sig = void(int);
+using Del = delegate<Sig>;
+
+struct Handler
+{
+    void onEvent(int x) const
+    {
+        benchmark::DoNotOptimize(x + id);
+    }
+    int id = 0;
+};
+
+// Baseline: one vector of delegates behind one mutex.
+class locked_signal
+{
+  public:
+    using handle = std::uint64_t;
+
+    handle connect(Del del)
+    {
+        std::lock_guard<std::mutex> lock(m_lock);
+        m_dels.emplace_back(++m_lastId, del);
+        return m_lastId;
+    }
+
+    bool disconnect(handle h)
+    {
+        std::lock_guard<std::mutex> lock(m_lock);
+        auto it = std::find_if(m_dels.begin(), m_dels.end(),
+                               [h](const std::pair<handle, Del>& e) {
+                                   return e.first == h;
+                               });
+        if (it == m_dels.end())
+            return false;
+        *it = m_dels.back();
+        m_dels.pop_back();
+        return true;
+    }
+
+    void emit(int x)
+    {
+        std::lock_guard<std::mutex> lock(m_lock);
+        for (auto& e : m_dels)
+            e.second(x);
+    }
+
+  private:
+    std::mutex m_lock;
+    std::vector<std::pair<handle, Del>> m_dels;
+    handle m_lastId = 0;
+};
+
+sharded_signal<Sig, 64> g_sharded;
+locked_signal g_locked;
+Handler g_handlers[64];
+
+template <typename Signal>
+void
+connectDisconnect(benchmark::State& state, Signal& sig)
+{
+    auto del = Del::make<&Handler::onEvent>(
+        g_handlers[static_cast<std::size_t>(state.thread_index()) % 64]);
+    for (auto _ : state)
+    {
+        auto h = sig.connect(del);
+        sig.disconnect(h);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+void
+BM_sharded_connect_disconnect(benchmark::State& state)
+{
+    connectDisconnect(state, g_sharded);
+}
+
+void
+BM_locked_connect_disconnect(benchmark::State& state)
+{
+    connectDisconnect(state, g_locked);
+}
+
+// Emit to 64 subscribers connected from 'range(0)' threads.
+template <typename Signal>
+void
+emit(benchmark::State& state)
+{
+    Signal sig;
+    std::vector<std::thread> threads;
+    auto connectors = static_cast<std::size_t>(state.range(0));
+    for (std::size_t t = 0; t < connectors; ++t)
+    {
+        threads.emplace_back([&sig, t, connectors] {
+            for (std::size_t i = t; i < 64; i += connectors)
+                sig.connect(Del::make<&Handler::onEvent>(g_handlers[i]));
+        });
+    }
+    for (auto& t : threads)
+        t.join();
+    for (auto _ : state)
+        sig.emit(1);
+    state.SetItemsProcessed(state.iterations() * 64);
+}
+
+void
+BM_sharded_emit(benchmark::State& state)
+{
+    emit<sharded_signal<Sig, 64>>(state);
+}
+
+void
+BM_locked_emit(benchmark::State& state)
+{
+    emit<locked_signal>(state);
+}
+} // namespace
+
+BENCHMARK(BM_sharded_connect_disconnect)->ThreadRange(1, 64)->UseRealTime();
+BENCHMARK(BM_locked_connect_disconnect)->ThreadRange(1, 64)->UseRealTime();
+BENCHMARK(BM_sharded_emit)->Arg(1)->Arg(8);
+BENCHMARK(BM_locked_emit)->Arg(1)->Arg(8);
@@ -0,0 +1,212 @@
+#include "delegate/shm_delegate.hpp"
+
+#include <atomic>
+#include <new>
+
+#include <sched.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <benchmark/benchmark.h>
+
+namespace
+{
+struct Counter
+{
+    void add(int v)
+    {
+        sum += v;
+        received.store(received.load(std::memory_order_relaxed) + 1,
+                       std::memory_order_release);
+    }
+    long sum = 0;
+    std::atomic<std::int64_t> received{0};
+};
+
+using Registry = shm_registry<&Counter::add>;
+using Queue = shm_queue<void(int), 1024>;
+
+// Shared between the benchmark and a child process.
+struct Region
+{
+    Queue toChild;
+    Queue toParent;
+    Counter childCounter;
+    Counter parentCounter;
+    std::atomic<bool> stop{false};
+};
+
+static_assert(std::atomic<bool>::is_always_lock_free, "");
+
+template <typename Fn>
+pid_t
+spawn(Fn child)
+{
+    pid_t pid = ::fork();
+    if (pid == 0)
+    {
+        child();
+        ::_exit(0);
+    }
+    return pid;
+}
+
+Region*
+makeRegion()
+{
+    void* mem = ::mmap(nullptr, sizeof(Region), PROT_READ | PROT_WRITE,
+                       MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    return new (mem) Region;
+}
+
+void
+freeRegion(Region* r)
+{
+    r->~Region();
+    ::munmap(r, sizeof(Region));
+}
+
+// Child running every call posted to 'toChild'. If 'echo', answer each one.
+void
+serveShm(Region* r, bool echo)
+{
+    auto reply = Registry::make<&Counter::add>(r, r->parentCounter);
+    std::int64_t seen = 0;
+    while (!r->stop.load(std::memory_order_acquire))
+    {
+        if (r->toChild.poll<Registry>(r, sizeof(Region)) == 0)
+        {
+            ::sched_yield();
+            continue;
+        }
+        if (!echo)
+            continue;
+        auto received = r->childCounter.received.load();
+        for (; seen < received; ++seen)
+            while (!r->toParent.try_post(reply, 1))
+                ::sched_yield();
+    }
+}
+
+void
+BM_shm_queue_throughput(benchmark::State& state)
+{
+    Region* r = makeRegion();
+    pid_t child = spawn([r] { serveShm(r, false); });
+    auto d = Registry::make<&Counter::add>(r, r->childCounter);
+    std::int64_t sent = 0;
+    for (auto _ : state)
+    {
+        while (!r->toChild.try_post(d, 1))
+            ::sched_yield();
+        ++sent;
+    }
+    while (r->childCounter.received.load(std::memory_order_acquire) != sent)
+        ::sched_yield();
+    r->stop = true;
+    ::waitpid(child, nullptr, 0);
+    state.SetItemsProcessed(state.iterations());
+    freeRegion(r);
+}
+
+void
+BM_shm_queue_round_trip(benchmark::State& state)
+{
+    Region* r = makeRegion();
+    pid_t child = spawn([r] { serveShm(r, true); });
+    auto d = Registry::make<&Counter::add>(r, r->childCounter);
+    for (auto _ : state)
+    {
+        r->toChild.try_post(d, 1);
+        while (r->toParent.poll<Registry>(r, sizeof(Region)) == 0)
+            ::sched_yield();
+    }
+    r->stop = true;
+    ::waitpid(child, nullptr, 0);
+    state.SetItemsProcessed(state.iterations());
+    freeRegion(r);
+}
+
+// Baseline: a message {id, argument} through a pipe, dispatched by id.
+struct Message
+{
+    std::uint32_t id;
+    int arg;
+};
+
+void
+servePipe(int in, int out, bool echo)
+{
+    Counter counter;
+    Message batch[64];
+    for (;;)
+    {
+        auto n = ::read(in, batch, sizeof(batch));
+        if (n <= 0)
+            return;
+        auto count = static_cast<std::size_t>(n) / sizeof(Message);
+        for (std::size_t i = 0; i < count; ++i)
+            if (batch[i].id == 0)
+                counter.add(batch[i].arg);
+        if (echo)
+            (void)::write(out, batch, count * sizeof(Message));
+    }
+}
+
+void
+BM_pipe_throughput(benchmark::State& state)
+{
+    int toChild[2];
+    int ack[2];
+    (void)::pipe(toChild);
+    (void)::pipe(ack);
+    pid_t child = spawn([&] {
+        ::close(toChild[1]);
+        servePipe(toChild[0], -1, false);
+        char done = 1;
+        (void)::write(ack[1], &done, 1);
+    });
+    ::close(toChild[0]);
+    Message m{0, 1};
+    for (auto _ : state)
+        (void)::write(toChild[1], &m, sizeof(m));
+    ::close(toChild[1]);
+    char done;
+    (void)::read(ack[0], &done, 1);
+    ::waitpid(child, nullptr, 0);
+    ::close(ack[0]);
+    ::close(ack[1]);
+    state.SetItemsProcessed(state.iterations());
+}
+
+void
+BM_pipe_round_trip(benchmark::State& state)
+{
+    int toChild[2];
+    int toParent[2];
+    (void)::pipe(toChild);
+    (void)::pipe(toParent);
+    pid_t child = spawn([&] {
+        ::close(toChild[1]);
+        servePipe(toChild[0], toParent[1], true);
+    });
+    ::close(toChild[0]);
+    Message m{0, 1};
+    for (auto _ : state)
+    {
+        (void)::write(toChild[1], &m, sizeof(m));
+        (void)::read(toParent[0], &m, sizeof(m));
+    }
+    ::close(toChild[1]);
+    ::waitpid(child, nullptr, 0);
+    ::close(toParent[0]);
+    ::close(toParent[1]);
+    state.SetItemsProcessed(state.iterations());
+}
+} // namespace
+
+BENCHMARK(BM_shm_queue_throughput)->UseRealTime();
+BENCHMARK(BM_pipe_throughput)->UseRealTime();
+BENCHMARK(BM_shm_queue_round_trip)->UseRealTime();
+BENCHMARK(BM_pipe_round_trip)->UseRealTime();
@@ -0,0 +1,95 @@
+#include "delegate/task_graph.hpp"
+
+#include <random>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+namespace
+{
+using Task = task_graph::Task;
+
+constexpr std::size_t stageCount = 200;
+
+// About 1us of arithmetic.
+struct Stage
+{
+    void run()
+    {
+        unsigned v = seed;
+        for (int i = 0; i < 300; ++i)
+            v = v * 1664525u + 1013904223u;
+        result = v;
+    }
+    unsigned seed = 1;
+    unsigned result = 0;
+};
+
+// Random DAG, each stage depending on up to 'fanIn' earlier stages.
+void
+build(task_graph& graph, std::vector<Stage>& stages, int fanIn)
+{
+    std::mt19937 rng{42};
+    for (auto& s : stages)
+        graph.add(Task::make<&Stage::run>(s));
+    for (task_graph::node_id i = 1; i < stages.size(); ++i)
+    {
+        std::uniform_int_distribution<task_graph::node_id> pick(0, i - 1);
+        for (int e = 0; e < fanIn; ++e)
+            graph.precede(pick(rng), i);
+    }
+}
+
+// Baseline: the stages called in a valid order on one thread.
+void
+BM_stages_sequential(benchmark::State& state)
+{
+    std::vector<Stage> stages(stageCount);
+    std::vector<Task> tasks;
+    for (auto& s : stages)
+        tasks.push_back(Task::make<&Stage::run>(s));
+    for (auto _ : state)
+        for (auto& t : tasks)
+            t();
+    state.SetItemsProcessed(state.iterations() * stageCount);
+}
+
+// range(0): workers, range(1): fan in.
+void
+BM_task_graph_run(benchmark::State& state)
+{
+    std::vector<Stage> stages(stageCount);
+    task_graph graph;
+    build(graph, stages, static_cast<int>(state.range(1)));
+    thread_pool pool{static_cast<std::size_t>(state.range(0))};
+    graph.run(pool);
+    for (auto _ : state)
+        graph.run(pool);
+    state.SetItemsProcessed(state.iterations() * stageCount);
+}
+
+void
+BM_task_graph_run_timed(benchmark::State& state)
+{
+    std::vector<Stage> stages(stageCount);
+    task_graph graph;
+    build(graph, stages, 2);
+    graph.set_timing(true);
+    thread_pool pool{static_cast<std::size_t>(state.range(0))};
+    std::vector<task_graph::node_id> path;
+    graph.run(pool);
+    for (auto _ : state)
+    {
+        graph.run(pool);
+        benchmark::DoNotOptimize(graph.critical_path(path));
+    }
+    state.SetItemsProcessed(state.iterations() * stageCount);
+    state.counters["critical_path_nodes"] = static_cast<double>(path.size());
+}
+} // namespace
+
+BENCHMARK(BM_stages_sequential);
+BENCHMARK(BM_task_graph_run)
+    ->ArgsProduct({{0, 1, 3, 7}, {1, 2, 4}})
+    ->UseRealTime();
+BENCHMARK(BM_task_graph_run_timed)->Arg(0)->Arg(3)->UseRealTime();
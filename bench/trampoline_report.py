@@ -0,0 +1,76 @@
+#!/usr/bin/env python3
+"""
+Report the delegate trampolines linked into binaries.
+
+List the symbols of each binary with nm, keep the delegate trampolines
+(doFreeCB, doMemberCB, doFunctor, ...) and print their count and total size
+in bytes, by kind. Useful to compare a build with and without
+DELEGATE_FOLD_TRAMPOLINES.
+
+    python3 bench/trampoline_report.py delegate_test_17.out [more.out ...]
+"""
+
+import argparse
+import re
+import subprocess
+import sys
+
+KINDS = (
+    "doNullFkn",
+    "doFreeCB",
+    "doMemberCB",
+    "doConstMemberCB",
+    "doFunctor",
+    "doConstFunctor",
+    "doRuntimeFkn",
+    "dofreeFknWithObjectRef",
+    "dofreeFknWithObjectConstRef",
+)
+
+# Demangled name, e.g. "delegate<int (int)>::doFreeCB<&freeFkn>(...)".
+TRAMPOLINE = re.compile(r"\bdelegate<.*>::(%s)\b" % "|".join(KINDS))
+
+
+def trampolines(binary, nm):
+    out = subprocess.run([nm, "-C", "-S", "--defined-only", binary],
+                         check=True, stdout=subprocess.PIPE,
+                         universal_newlines=True).stdout
+    for line in out.splitlines():
+        # address size type name
+        parts = line.split(None, 3)
+        if len(parts) != 4 or parts[2].lower() not in ("t", "w"):
+            continue
+        match = TRAMPOLINE.search(parts[3])
+        if match:
+            yield match.group(1), int(parts[1], 16)
+
+
+def report(binary, nm):
+    count = dict.fromkeys(KINDS, 0)
+    size = dict.fromkeys(KINDS, 0)
+    for kind, bytes_ in trampolines(binary, nm):
+        count[kind] += 1
+        size[kind] += bytes_
+    print(binary)
+    print("  %-28s %8s %8s" % ("trampoline", "count", "bytes"))
+    for kind in KINDS:
+        if count[kind]:
+            print("  %-28s %8d %8d" % (kind, count[kind], size[kind]))
+    print("  %-28s %8d %8d"
+          % ("total", sum(count.values()), sum(size.values())))
+
+
+def main():
+    parser = argparse.ArgumentParser()
+    parser.add_argument("binaries", nargs="+")
+    parser.add_argument("--nm", default="nm")
+    args = parser.parse_args()
+    for binary in args.binaries:
+        try:
+            report(binary, args.nm)
+        except (OSError, subprocess.CalledProcessError) as e:
+            sys.exit("%s: %s" % (binary, e))
+
+
+if __name__ == "__main__":
+    main()
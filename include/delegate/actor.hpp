@@ -0,0 +1,252 @@
+/*
+ * actor.hpp
+ *
+ *  Created on: 18 oct. 2026
+ */
+
+#ifndef DELEGATE_ACTOR_HPP_
+#define DELEGATE_ACTOR_HPP_
+
+#include "delegate/delegate.hpp"
+#include "delegate/thread_pool.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+/**
+ * Object whose handlers are run one at a time on a shared thread_pool.
+ *
+ *   actor<Account> account{pool};
+ *   mail<void(int)> deposit;  // Owned by the sender, reused.
+ *   account.tell<&Account::deposit>(deposit, 100);
+ *
+ * Messages are 'mail' objects provided by the sender: a delegate plus its
+ * arguments. They are linked into an intrusive lock-free MPSC queue, posting
+ * does not allocate and does not take a lock. The actor is handed to the
+ * pool when its mailbox goes from empty to non-empty, then runs up to
+ * 'Batch' messages in a row before yielding the worker. Handlers of one
+ * actor never run concurrently, and run in posting order for a given sender.
+ *
+ * A mail must not be posted again before its handler has been called. It
+ * can be posted again from the handler itself. If the pool queue is full the
+ * actor runs on the posting thread.
+ *
+ * An actor must be idle when destroyed, see 'idle'.
+ */
+
+#if __cplusplus < 201703L
+#error "Require at least C++17 to compile actor"
+#endif
+
+namespace details
+{
+struct MailboxNode
+{
+    std::atomic<MailboxNode*> next{nullptr};
+    delegate<void(MailboxNode&)> run;
+};
+
+// Vyukov intrusive MPSC queue.
+class Mailbox
+{
+  public:
+    Mailbox() noexcept : m_head(&m_stub), m_tail(&m_stub) {}
+
+    Mailbox(const Mailbox&) = delete;
+    Mailbox& operator=(const Mailbox&) = delete;
+
+    // Any thread.
+    void push(MailboxNode& node) noexcept
+    {
+        node.next.store(nullptr, std::memory_order_relaxed);
+        MailboxNode* prev = m_head.exchange(&node, std::memory_order_acq_rel);
+        prev->next.store(&node, std::memory_order_release);
+    }
+
+    /**
+     * Consumer only. Return nullptr if empty, or if a producer is between
+     * the two steps of 'push'.
+     */
+    MailboxNode* pop() noexcept
+    {
+        MailboxNode* tail = m_tail;
+        MailboxNode* next = tail->next.load(std::memory_order_acquire);
+        if (tail == &m_stub)
+        {
+            if (!next)
+                return nullptr;
+            m_tail = next;
+            tail = next;
+            next = next->next.load(std::memory_order_acquire);
+        }
+        if (next)
+        {
+            m_tail = next;
+            return tail;
+        }
+        if (tail != m_head.load(std::memory_order_acquire))
+            return nullptr;
+        push(m_stub);
+        next = tail->next.load(std::memory_order_acquire);
+        if (next)
+        {
+            m_tail = next;
+            return tail;
+        }
+        return nullptr;
+    }
+
+  private:
+    std::atomic<MailboxNode*> m_head;
+    MailboxNode* m_tail;
+    MailboxNode m_stub;
+};
+} // namespace details
+
+template <typename T>
+class mail;
+
+/**
+ * Message carrying a delegate<void(Args...)> and a copy of its arguments.
+ * Arguments are stored decayed, a handler taking 'const T&' gets a
+ * reference to the copy held by the mail.
+ */
+template <typename... Args>
+class mail<void(Args...)> : public details::MailboxNode
+{
+  public:
+    using Del = delegate<void(Args...)>;
+
+    mail() noexcept
+    {
+        run = delegate<void(details::MailboxNode&)>::make<&mail::dispatch>();
+    }
+
+    mail(const mail&) = delete;
+    mail& operator=(const mail&) = delete;
+
+    template <typename... A>
+    void set(Del del, A&&... args)
+    {
+        m_del = del;
+        m_args = Stored(std::forward<A>(args)...);
+    }
+
+  private:
+    static void dispatch(details::MailboxNode& node)
+    {
+        auto& self = static_cast<mail&>(node);
+        // Stored values passed as the delegate trampolines pass them.
+        std::apply(
+            [&self](auto&... args) {
+                self.m_del(
+                    static_cast<typename details::PassArg<Args>::type>(
+                        args)...);
+            },
+            self.m_args);
+    }
+
+    using Stored = std::tuple<std::decay_t<Args>...>;
+
+    Del m_del;
+    Stored m_args;
+};
+
+template <typename T, std::size_t Batch = 32>
+class actor
+{
+  public:
+    template <typename... A>
+    explicit actor(thread_pool& pool, A&&... args)
+        : m_pool(pool), m_obj(std::forward<A>(args)...)
+    {
+    }
+
+    actor(const actor&) = delete;
+    actor& operator=(const actor&) = delete;
+
+    /**
+     * Post 'm' with its delegate and arguments already set. The delegate
+     * should call into the object returned by 'get'.
+     */
+    template <typename Sig>
+    void post(mail<Sig>& m) noexcept
+    {
+        // Counted first, so a running batch never sees more messages than
+        // 'm_pending'.
+        auto prev = m_pending.fetch_add(1, std::memory_order_acq_rel);
+        m_mailbox.push(m);
+        if (prev == 0)
+            schedule();
+    }
+
+    // Post a call of member function 'mFkn' of the actor object.
+    template <auto mFkn, typename... Args, typename... A>
+    void tell(mail<void(Args...)>& m, A&&... args)
+    {
+        using Del = delegate<void(Args...)>;
+        m.set(Del::template make<mFkn>(m_obj), std::forward<A>(args)...);
+        post(m);
+    }
+
+    // Only to be used from handlers, or while the actor is idle.
+    T& get() noexcept
+    {
+        return m_obj;
+    }
+
+    // Posted messages whose handler has not returned yet.
+    std::size_t pending() const noexcept
+    {
+        return m_pending.load(std::memory_order_acquire);
+    }
+
+    bool idle() const noexcept
+    {
+        return pending() == 0;
+    }
+
+  private:
+    void schedule() noexcept
+    {
+        using Task = thread_pool::Task;
+        if (!m_pool.try_submit(Task::make<&actor::process>(*this)))
+            process();
+    }
+
+    /**
+     * Run up to Batch messages, then reschedule if more were posted. Nothing
+     * is touched after the final decrement, the actor may be destroyed.
+     */
+    void process()
+    {
+        std::size_t done = 0;
+        while (done < Batch)
+        {
+            details::MailboxNode* node = m_mailbox.pop();
+            if (!node)
+            {
+                // Empty, or a producer is half way through 'post'.
+                if (m_pending.load(std::memory_order_acquire) == done)
+                    break;
+                std::this_thread::yield();
+                continue;
+            }
+            node->run(*node);
+            ++done;
+        }
+        if (m_pending.fetch_sub(done, std::memory_order_acq_rel) != done)
+            schedule();
+    }
+
+    thread_pool& m_pool;
+    details::Mailbox m_mailbox;
+    std::atomic<std::size_t> m_pending{0};
+    T m_obj;
+};
+
+#endif /* DELEGATE_ACTOR_HPP_ */
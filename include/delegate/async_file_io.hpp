@@ -0,0 +1,484 @@
+/*
+ * async_file_io.hpp
+ *
+ *  Created on: 18 oct. 2026
+ */
+
+#ifndef DELEGATE_ASYNC_FILE_IO_HPP_
+#define DELEGATE_ASYNC_FILE_IO_HPP_
+
+#include "delegate/delegate.hpp"
+#include "delegate/thread_pool.hpp"
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+#include <vector>
+
+#include <cerrno>
+#include <unistd.h>
+
+#if defined(__linux__) && __has_include(<linux/io_uring.h>)
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#define DELEGATE_HAS_IO_URING 1
+#else
+#define DELEGATE_HAS_IO_URING 0
+#endif
+
+/**
+ * Asynchronous file reads and writes completing into delegate<void(int)>.
+ *
+ *   thread_pool pool{2};
+ *   async_file_io io{pool};
+ *   io.read(fd, buf, 4096, 0, Completion::make<&Snapshot::onRead>(snap));
+ *   io.write(fd2, data, len, 0, Completion::make<&Log::onWritten>(log));
+ *   io.submit(); // One system call for the whole batch.
+ *   ...
+ *   io.reap(); // Call the completions of finished operations.
+ *
+ * Completions receive the result of the operation: the number of bytes
+ * transferred or a negated errno value, as pread/pwrite would. If io_uring
+ * refuses a submission, the operations not submitted complete with the
+ * negated errno of io_uring_enter.
+ *
+ * On Linux operations go through io_uring, set up with raw system calls.
+ * When io_uring is not available, or lacks the read and write operations
+ * (kernels before 5.6, seccomp, other systems), they are run with
+ * pread/pwrite on the fallback thread_pool.
+ *
+ * Completion delegates are held in a slot table allocated on construction,
+ * the slot index is the io_uring 'user_data'. At most 'capacity' operations
+ * can be in flight, read and write return false beyond that. Nothing is
+ * allocated per operation.
+ *
+ * Completions are always called from 'reap' or 'wait', on the calling
+ * thread, and may start new operations. An async_file_io object must only be
+ * used from one thread at a time. Buffers must stay valid until the
+ * completion is called. The destructor waits for all in-flight operations
+ * and calls their completions.
+ */
+
+#if __cplusplus < 201703L
+#error "Require at least C++17 to compile async_file_io"
+#endif
+
+class async_file_io
+{
+  public:
+    using Completion = delegate<void(int)>;
+
+    enum class backend
+    {
+        io_uring,
+        threads
+    };
+
+    /**
+     * 'fallback' is only used if io_uring can't be used, or if 'useIoUring'
+     * is false. It must outlive this object.
+     */
+    explicit async_file_io(thread_pool& fallback, std::size_t capacity = 256,
+                           bool useIoUring = true)
+        : m_pool(fallback), m_slots(capacity)
+    {
+        m_free.reserve(capacity);
+        for (std::size_t i = capacity; i > 0; --i)
+            m_free.push_back(static_cast<std::uint32_t>(i - 1));
+        for (auto& slot : m_slots)
+            slot.io = this;
+        m_queue.reserve(capacity);
+        m_completed.reserve(capacity);
+        m_reaping.reserve(capacity);
+        m_backend = backend::threads;
+#if DELEGATE_HAS_IO_URING
+        if (useIoUring && capacity != 0 && m_ring.setup(capacity))
+            m_backend = backend::io_uring;
+#else
+        (void)useIoUring;
+#endif
+    }
+
+    async_file_io(const async_file_io&) = delete;
+    async_file_io& operator=(const async_file_io&) = delete;
+
+    ~async_file_io()
+    {
+        drain();
+    }
+
+    // Queue a read. Return false if 'capacity' operations are in flight.
+    bool read(int fd, void* buf, std::size_t len, std::uint64_t offset,
+              Completion done)
+    {
+        return prepare(opRead, fd, buf, len, offset, done);
+    }
+
+    // Queue a write. Return false if 'capacity' operations are in flight.
+    bool write(int fd, const void* buf, std::size_t len,
+               std::uint64_t offset, Completion done)
+    {
+        return prepare(opWrite, fd, const_cast<void*>(buf), len, offset,
+                       done);
+    }
+
+    // Start all queued operations. Return how many were started.
+    std::size_t submit()
+    {
+        return enter(0);
+    }
+
+    /**
+     * Call the completions of all finished operations without blocking.
+     * Return the number of completions called.
+     */
+    std::size_t reap()
+    {
+#if DELEGATE_HAS_IO_URING
+        if (m_backend == backend::io_uring)
+            return reapRing();
+#endif
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_reaping.swap(m_completed);
+        }
+        for (auto index : m_reaping)
+            complete(index, m_slots[index].result);
+        auto n = m_reaping.size();
+        m_reaping.clear();
+        return n;
+    }
+
+    /**
+     * Submit queued operations then block until at least 'minCompletions'
+     * operations have finished, or none are in flight. Call the completions
+     * and return their number.
+     */
+    std::size_t wait(std::size_t minCompletions = 1)
+    {
+        if (minCompletions > in_flight())
+            minCompletions = in_flight();
+        enter(static_cast<unsigned>(minCompletions));
+        if (m_backend == backend::threads)
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_cv.wait(lock, [&] {
+                return m_completed.size() >= minCompletions;
+            });
+        }
+        return reap();
+    }
+
+    /**
+     * Wait for all in-flight operations and call their completions. Return
+     * early, with operations still in flight, if io_uring can not wait for
+     * them anymore.
+     */
+    void drain()
+    {
+        while (in_flight() != 0)
+            if (wait(in_flight()) == 0)
+                return;
+    }
+
+    // Operations queued or running whose completion was not called yet.
+    std::size_t in_flight() const noexcept
+    {
+        return m_slots.size() - m_free.size();
+    }
+
+    std::size_t capacity() const noexcept
+    {
+        return m_slots.size();
+    }
+
+    backend get_backend() const noexcept
+    {
+        return m_backend;
+    }
+
+  private:
+    enum : std::uint8_t
+    {
+        opRead,
+        opWrite
+    };
+
+    struct Slot
+    {
+        // Fallback path, run on a pool thread.
+        void operator()()
+        {
+            auto offset = static_cast<off_t>(off);
+            ssize_t res = op == opRead ? ::pread(fd, buf, len, offset)
+                                       : ::pwrite(fd, buf, len, offset);
+            result = res < 0 ? -errno : static_cast<int>(res);
+            io->finished(this);
+        }
+
+        Completion done;
+        async_file_io* io = nullptr;
+        void* buf = nullptr;
+        std::size_t len = 0;
+        std::uint64_t off = 0;
+        int fd = -1;
+        int result = 0;
+        std::uint8_t op = opRead;
+    };
+
+#if DELEGATE_HAS_IO_URING
+    // Mapping of the io_uring submission and completion rings.
+    struct Ring
+    {
+        Ring() = default;
+        Ring(const Ring&) = delete;
+        Ring& operator=(const Ring&) = delete;
+
+        ~Ring()
+        {
+            if (sqes)
+                ::munmap(sqes, sqesSize);
+            if (cqMap && cqMap != sqMap)
+                ::munmap(cqMap, cqMapSize);
+            if (sqMap)
+                ::munmap(sqMap, sqMapSize);
+            if (fd >= 0)
+                ::close(fd);
+        }
+
+        bool setup(std::size_t entries)
+        {
+            io_uring_params p;
+            std::memset(&p, 0, sizeof(p));
+            long res = ::syscall(__NR_io_uring_setup,
+                                 static_cast<unsigned>(entries), &p);
+            if (res < 0)
+                return false;
+            fd = static_cast<int>(res);
+
+            sqMapSize = p.sq_off.array + p.sq_entries * sizeof(unsigned);
+            cqMapSize = p.cq_off.cqes + p.cq_entries * sizeof(io_uring_cqe);
+            bool single = (p.features & IORING_FEAT_SINGLE_MMAP) != 0;
+            if (single && cqMapSize > sqMapSize)
+                sqMapSize = cqMapSize;
+            sqMap = map(sqMapSize, IORING_OFF_SQ_RING);
+            if (!sqMap)
+                return false;
+            cqMap = single ? sqMap : map(cqMapSize, IORING_OFF_CQ_RING);
+            if (!cqMap)
+                return false;
+            sqesSize = p.sq_entries * sizeof(io_uring_sqe);
+            sqes = static_cast<io_uring_sqe*>(map(sqesSize, IORING_OFF_SQES));
+            if (!sqes)
+                return false;
+
+            auto sq = static_cast<char*>(sqMap);
+            auto cq = static_cast<char*>(cqMap);
+            sqTail = reinterpret_cast<unsigned*>(sq + p.sq_off.tail);
+            sqMask = *reinterpret_cast<unsigned*>(sq + p.sq_off.ring_mask);
+            sqArray = reinterpret_cast<unsigned*>(sq + p.sq_off.array);
+            cqHead = reinterpret_cast<unsigned*>(cq + p.cq_off.head);
+            cqTail = reinterpret_cast<unsigned*>(cq + p.cq_off.tail);
+            cqMask = *reinterpret_cast<unsigned*>(cq + p.cq_off.ring_mask);
+            cqes = reinterpret_cast<io_uring_cqe*>(cq + p.cq_off.cqes);
+            return supports(IORING_OP_READ) && supports(IORING_OP_WRITE);
+        }
+
+        /**
+         * Kernels 5.1 to 5.5 have io_uring but not IORING_OP_READ and
+         * IORING_OP_WRITE, these would complete with -EINVAL. They also lack
+         * IORING_REGISTER_PROBE, so a failing probe means no support.
+         */
+        bool supports(unsigned opcode)
+        {
+            constexpr unsigned maxOps = 256;
+            constexpr std::size_t size =
+                sizeof(io_uring_probe) + maxOps * sizeof(io_uring_probe_op);
+            alignas(io_uring_probe) unsigned char buf[size];
+            std::memset(buf, 0, sizeof(buf));
+            auto probe = reinterpret_cast<io_uring_probe*>(buf);
+            long res = ::syscall(__NR_io_uring_register, fd,
+                                 IORING_REGISTER_PROBE, probe, maxOps);
+            if (res < 0 || opcode > probe->last_op)
+                return false;
+            return (probe->ops[opcode].flags & IO_URING_OP_SUPPORTED) != 0;
+        }
+
+        void* map(std::size_t size, off_t offset)
+        {
+            void* ptr = ::mmap(nullptr, size, PROT_READ | PROT_WRITE,
+                               MAP_SHARED | MAP_POPULATE, fd, offset);
+            return ptr == MAP_FAILED ? nullptr : ptr;
+        }
+
+        int fd = -1;
+        void* sqMap = nullptr;
+        std::size_t sqMapSize = 0;
+        void* cqMap = nullptr;
+        std::size_t cqMapSize = 0;
+        io_uring_sqe* sqes = nullptr;
+        std::size_t sqesSize = 0;
+        unsigned* sqTail = nullptr;
+        unsigned* sqArray = nullptr;
+        unsigned sqMask = 0;
+        unsigned* cqHead = nullptr;
+        unsigned* cqTail = nullptr;
+        unsigned cqMask = 0;
+        io_uring_cqe* cqes = nullptr;
+    };
+
+    // In-flight operations never exceed the ring size, the queue can't
+    // overflow.
+    void pushSqe(std::uint32_t index)
+    {
+        const Slot& slot = m_slots[index];
+        unsigned tail = *m_ring.sqTail;
+        unsigned i = tail & m_ring.sqMask;
+        io_uring_sqe* sqe = &m_ring.sqes[i];
+        std::memset(sqe, 0, sizeof(*sqe));
+        sqe->opcode = slot.op == opRead ? IORING_OP_READ : IORING_OP_WRITE;
+        sqe->fd = slot.fd;
+        sqe->addr = reinterpret_cast<std::uint64_t>(slot.buf);
+        sqe->len = static_cast<std::uint32_t>(slot.len);
+        sqe->off = slot.off;
+        sqe->user_data = index;
+        m_ring.sqArray[i] = i;
+        __atomic_store_n(m_ring.sqTail, tail + 1, __ATOMIC_RELEASE);
+    }
+
+    /**
+     * Take back the entries the kernel did not consume, the last 'm_queued'
+     * ones, and complete them with 'error'. Completions may queue again.
+     */
+    void failQueued(int error)
+    {
+        std::vector<std::uint32_t> failed;
+        failed.reserve(m_queued);
+        unsigned tail = *m_ring.sqTail - m_queued;
+        for (unsigned i = 0; i < m_queued; ++i)
+        {
+            const io_uring_sqe& sqe = m_ring.sqes[(tail + i) & m_ring.sqMask];
+            failed.push_back(static_cast<std::uint32_t>(sqe.user_data));
+        }
+        __atomic_store_n(m_ring.sqTail, tail, __ATOMIC_RELEASE);
+        m_queued = 0;
+        for (auto index : failed)
+            complete(index, error);
+    }
+
+    std::size_t reapRing()
+    {
+        std::size_t n = 0;
+        unsigned head = *m_ring.cqHead;
+        while (head != __atomic_load_n(m_ring.cqTail, __ATOMIC_ACQUIRE))
+        {
+            const io_uring_cqe& cqe = m_ring.cqes[head & m_ring.cqMask];
+            auto index = static_cast<std::uint32_t>(cqe.user_data);
+            int res = cqe.res;
+            __atomic_store_n(m_ring.cqHead, ++head, __ATOMIC_RELEASE);
+            complete(index, res);
+            ++n;
+        }
+        return n;
+    }
+#endif
+
+    bool prepare(std::uint8_t op, int fd, void* buf, std::size_t len,
+                 std::uint64_t offset, Completion done)
+    {
+        if (m_free.empty())
+            return false;
+        auto index = m_free.back();
+        m_free.pop_back();
+        Slot& slot = m_slots[index];
+        slot.done = done;
+        slot.buf = buf;
+        slot.len = len;
+        slot.off = offset;
+        slot.fd = fd;
+        slot.op = op;
+#if DELEGATE_HAS_IO_URING
+        if (m_backend == backend::io_uring)
+        {
+            pushSqe(index);
+            ++m_queued;
+            return true;
+        }
+#endif
+        m_queue.push_back(index);
+        return true;
+    }
+
+    // Submit queued operations, for io_uring optionally wait for completions.
+    std::size_t enter(unsigned minComplete)
+    {
+#if DELEGATE_HAS_IO_URING
+        if (m_backend == backend::io_uring)
+        {
+            std::size_t submitted = 0;
+            for (;;)
+            {
+                unsigned flags = minComplete ? IORING_ENTER_GETEVENTS : 0;
+                long res = ::syscall(__NR_io_uring_enter, m_ring.fd,
+                                     m_queued, minComplete, flags, nullptr, 0);
+                if (res < 0)
+                {
+                    if (errno == EINTR)
+                        continue;
+                    failQueued(-errno);
+                    return submitted;
+                }
+                submitted += static_cast<std::size_t>(res);
+                m_queued -= static_cast<unsigned>(res);
+                return submitted;
+            }
+        }
+#endif
+        (void)minComplete;
+        std::size_t n = m_queue.size();
+        for (auto index : m_queue)
+            if (!m_pool.try_submit(thread_pool::Task::make(m_slots[index])))
+                m_slots[index]();
+        m_queue.clear();
+        return n;
+    }
+
+    // Notify under the lock, the waiter may destroy this object right after.
+    void finished(const Slot* slot)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_completed.push_back(
+            static_cast<std::uint32_t>(slot - m_slots.data()));
+        m_cv.notify_one();
+    }
+
+    // Release the slot before the call, the completion may start new work.
+    void complete(std::uint32_t index, int result)
+    {
+        Completion done = m_slots[index].done;
+        m_free.push_back(index);
+        done(result);
+    }
+
+    thread_pool& m_pool;
+    std::vector<Slot> m_slots;
+    std::vector<std::uint32_t> m_free;
+    backend m_backend;
+
+    // Fallback path.
+    std::vector<std::uint32_t> m_queue;
+    std::mutex m_mutex;
+    std::condition_variable m_cv;
+    std::vector<std::uint32_t> m_completed;
+    std::vector<std::uint32_t> m_reaping;
+
+#if DELEGATE_HAS_IO_URING
+    Ring m_ring;
+    unsigned m_queued = 0;
+#endif
+};
+
+#endif /* DELEGATE_ASYNC_FILE_IO_HPP_ */
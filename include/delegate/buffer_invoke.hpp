@@ -0,0 +1,237 @@
+/*
+ * buffer_invoke.hpp
+ *
+ *  Created on: 18 oct. 2026
+ */
+
+#ifndef DELEGATE_BUFFER_INVOKE_HPP_
+#define DELEGATE_BUFFER_INVOKE_HPP_
+
+#include "delegate/delegate.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#if __cplusplus >= 202002L && __has_include(<span>)
+#include <span>
+#endif
+
+/**
+ * Call a delegate with arguments decoded from a byte buffer.
+ *
+ * The sender use 'encode_call' to write the arguments of a delegate signature
+ * into a buffer. The receiver use 'invoke_from_buffer' to call a delegate
+ * with the same signature. Each argument is copied straight from the buffer
+ * into the call, there is no intermediate tuple.
+ *
+ * Two layouts are supported:
+ * - packed_layout : Arguments follow each other without padding.
+ * - aligned_layout : Each argument is aligned to its natural alignment.
+ *   Arguments declared as 'const T&' in the signature then refer directly
+ *   into the buffer (zero copy). The buffer must be aligned to
+ *   'encoded_align' which is checked at runtime.
+ *
+ * All argument types must be trivially copyable. Encoding and decoding are
+ * done in host byte order.
+ *
+ *   using Sig = void(int, double);
+ *   std::byte buf[encoded_size<Sig>()];
+ *   encode_call<Sig>(buf, sizeof buf, 1, 2.5);
+ *   ...
+ *   invoke_from_buffer(del, buf, sizeof buf);
+ */
+
+#if __cplusplus < 201703L
+#error "Require at least C++17 to compile buffer_invoke"
+#endif
+
+struct packed_layout
+{
+    static constexpr bool aligned = false;
+};
+
+struct aligned_layout
+{
+    static constexpr bool aligned = true;
+};
+
+namespace details
+{
+template <typename T>
+using WireType = std::remove_cv_t<std::remove_reference_t<T>>;
+
+// Argument offsets in the buffer. Last element is the total size.
+template <typename Layout, typename... Ts>
+constexpr std::array<std::size_t, sizeof...(Ts) + 1>
+callOffsets() noexcept
+{
+    constexpr std::size_t sizes[] = {sizeof(Ts)..., 0};
+    constexpr std::size_t aligns[] = {alignof(Ts)..., 1};
+    std::array<std::size_t, sizeof...(Ts) + 1> offsets{};
+    std::size_t pos = 0;
+    for (std::size_t i = 0; i < sizeof...(Ts); ++i)
+    {
+        if (Layout::aligned)
+            pos = (pos + aligns[i] - 1) / aligns[i] * aligns[i];
+        offsets[i] = pos;
+        pos += sizes[i];
+    }
+    offsets[sizeof...(Ts)] = pos;
+    return offsets;
+}
+
+template <typename... Ts>
+constexpr std::size_t
+maxAlign() noexcept
+{
+    std::size_t a = 1;
+    ((a = alignof(Ts) > a ? alignof(Ts) : a), ...);
+    return a;
+}
+
+// Copy a value out of the buffer. The buffer need not be aligned.
+template <typename T>
+T
+loadArg(const std::byte* p) noexcept
+{
+    alignas(T) unsigned char raw[sizeof(T)];
+    std::memcpy(raw, p, sizeof(T));
+    return *std::launder(reinterpret_cast<T*>(raw));
+}
+
+// Aligned layout passing 'const T&' refer directly into the buffer.
+template <typename Layout, typename Arg>
+decltype(auto)
+decodeArg(const std::byte* p) noexcept
+{
+    using T = WireType<Arg>;
+    if constexpr (Layout::aligned && std::is_reference<Arg>::value)
+        return *std::launder(reinterpret_cast<const T*>(p));
+    else
+        return loadArg<T>(p);
+}
+
+template <typename Layout, typename Sig>
+struct CallCodec;
+
+template <typename Layout, typename R, typename... Args>
+struct CallCodec<Layout, R(Args...)>
+{
+    static_assert((std::is_trivially_copyable<WireType<Args>>::value && ...),
+                  "Buffer invocation require trivially copyable arguments");
+    static_assert(((!std::is_lvalue_reference<Args>::value ||
+                    std::is_const<std::remove_reference_t<Args>>::value) &&
+                   ...),
+                  "Arguments can not be non const references into a buffer");
+
+    static constexpr auto offsets = callOffsets<Layout, WireType<Args>...>();
+    static constexpr std::size_t size = offsets[sizeof...(Args)];
+    static constexpr std::size_t align =
+        Layout::aligned ? maxAlign<WireType<Args>...>() : 1;
+
+    static std::size_t encode(std::byte* out, std::size_t outSize,
+                              const WireType<Args>&... args) noexcept
+    {
+        if (outSize < size)
+            return 0;
+        if (Layout::aligned)
+            std::memset(out, 0, size);
+        encodeArgs(out, std::index_sequence_for<Args...>{}, args...);
+        return size;
+    }
+
+    static bool decode(const delegate<R(Args...)>& del, const std::byte* data,
+                       std::size_t dataSize) noexcept
+    {
+        if (dataSize < size ||
+            reinterpret_cast<std::uintptr_t>(data) % align != 0)
+            return false;
+        decodeArgs(del, data, std::index_sequence_for<Args...>{});
+        return true;
+    }
+
+  private:
+    // 'out' and 'data' are unused for a signature without arguments.
+    template <std::size_t... I>
+    static void encodeArgs([[maybe_unused]] std::byte* out,
+                           std::index_sequence<I...>,
+                           const WireType<Args>&... args) noexcept
+    {
+        (std::memcpy(out + offsets[I], &args, sizeof(WireType<Args>)), ...);
+    }
+
+    template <std::size_t... I>
+    static void decodeArgs(const delegate<R(Args...)>& del,
+                           [[maybe_unused]] const std::byte* data,
+                           std::index_sequence<I...>)
+    {
+        del(decodeArg<Layout, Args>(data + offsets[I])...);
+    }
+};
+} // namespace details
+
+// Number of bytes used to encode the arguments of 'Sig'.
+template <typename Sig, typename Layout = packed_layout>
+constexpr std::size_t
+encoded_size() noexcept
+{
+    return details::CallCodec<Layout, Sig>::size;
+}
+
+// Required alignment of a buffer to be decoded.
+template <typename Sig, typename Layout = packed_layout>
+constexpr std::size_t
+encoded_align() noexcept
+{
+    return details::CallCodec<Layout, Sig>::align;
+}
+
+/**
+ * Encode the arguments for a call with signature 'Sig' into 'out'.
+ * Return the number of bytes written or 0 if 'size' is too small.
+ */
+template <typename Sig, typename Layout = packed_layout, typename... Ts>
+std::size_t
+encode_call(std::byte* out, std::size_t size, Ts&&... args) noexcept
+{
+    return details::CallCodec<Layout, Sig>::encode(out, size,
+                                                   std::forward<Ts>(args)...);
+}
+
+/**
+ * Decode the arguments from 'data' and call 'del'. The return value of the
+ * delegate is discarded.
+ * Return false, without calling, if the buffer is too small or misaligned.
+ */
+template <typename Layout = packed_layout, typename R, typename... Args>
+bool
+invoke_from_buffer(const delegate<R(Args...)>& del, const std::byte* data,
+                   std::size_t size)
+{
+    return details::CallCodec<Layout, R(Args...)>::decode(del, data, size);
+}
+
+#if __cplusplus >= 202002L && __has_include(<span>)
+template <typename Sig, typename Layout = packed_layout, typename... Ts>
+std::size_t
+encode_call(std::span<std::byte> out, Ts&&... args) noexcept
+{
+    return encode_call<Sig, Layout>(out.data(), out.size(),
+                                    std::forward<Ts>(args)...);
+}
+
+template <typename Layout = packed_layout, typename R, typename... Args>
+bool
+invoke_from_buffer(const delegate<R(Args...)>& del,
+                   std::span<const std::byte> data)
+{
+    return invoke_from_buffer<Layout>(del, data.data(), data.size());
+}
+#endif
+
+#endif /* DELEGATE_BUFFER_INVOKE_HPP_ */
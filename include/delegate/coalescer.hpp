@@ -0,0 +1,208 @@
+/*
+ * coalescer.hpp
+ *
+ *  Created on: 18 oct. 2026
+ */
+
+#ifndef DELEGATE_COALESCER_HPP_
+#define DELEGATE_COALESCER_HPP_
+
+#include "delegate/delegate.hpp"
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+
+/**
+ * Collect delegate<void()> posts and run each unique delegate once per flush.
+ *
+ * Typical use is 'mark dirty' callbacks posted many times per frame where a
+ * single call per frame is enough:
+ *
+ *   coalescer<64> dirty;
+ *   dirty.post(Del::make<&Widget::redraw>(w)); // Any thread, many times.
+ *   dirty.flush(); // Once per frame, call Widget::redraw once.
+ *
+ * Delegates are deduplicated on delegate::equal using a fixed capacity open
+ * addressing hash set. At most N unique delegates can be pending, further
+ * posts return false and are counted in 'dropped'.
+ *
+ * Posting is safe from any number of threads and never take a lock. A post
+ * may briefly wait for another producer that is storing a delegate into the
+ * same slot, to be able to compare with it.
+ * Two tables are used. Flush switch producers over to the other table and
+ * waits for in-flight posts on the old one before running it. A delegate
+ * posted while flush is running ends up in the next flush.
+ * Flush must only be called from one thread at a time.
+ */
+
+#if __cplusplus < 201703L
+#error "Require at least C++17 to compile coalescer"
+#endif
+
+template <std::size_t N>
+class coalescer
+{
+  public:
+    using Del = delegate<void()>;
+
+    coalescer() = default;
+    coalescer(const coalescer&) = delete;
+    coalescer& operator=(const coalescer&) = delete;
+
+    /**
+     * Request a call to 'del' at the next flush.
+     * Return false if N unique delegates are already pending.
+     */
+    bool post(Del del) noexcept
+    {
+        Table* table = enter();
+        bool res = insert(*table, del);
+        table->writers.fetch_sub(1, std::memory_order_release);
+        if (!res)
+            m_dropped.fetch_add(1, std::memory_order_relaxed);
+        return res;
+    }
+
+    /**
+     * Call every delegate posted since last flush once, in the order they
+     * were first posted. Return the number of calls.
+     */
+    std::size_t flush()
+    {
+        auto index = m_active.load(std::memory_order_relaxed);
+        m_active.store(index ^ 1u, std::memory_order_seq_cst);
+        Table& table = m_tables[index];
+        while (table.writers.load(std::memory_order_seq_cst) != 0)
+            std::this_thread::yield();
+        std::atomic_thread_fence(std::memory_order_acquire);
+
+        auto count = table.used.load(std::memory_order_relaxed);
+        for (std::uint32_t i = 0; i < count; ++i)
+        {
+            Slot& slot = table.slots[table.order[i]];
+            Del del = slot.del;
+            slot.state.store(empty, std::memory_order_relaxed);
+            del();
+        }
+        table.used.store(0, std::memory_order_relaxed);
+        table.reserved.store(0, std::memory_order_release);
+        return count;
+    }
+
+    // Number of posts rejected since the coalescer was created.
+    std::size_t dropped() const noexcept
+    {
+        return m_dropped.load(std::memory_order_relaxed);
+    }
+
+    static constexpr std::size_t capacity() noexcept
+    {
+        return N;
+    }
+
+  private:
+    // Keep the load factor at or below 0.5.
+    static constexpr std::size_t slotCount = [] {
+        std::size_t n = 1;
+        while (n < 2 * N)
+            n *= 2;
+        return n;
+    }();
+
+    enum : std::uint8_t
+    {
+        empty,
+        writing,
+        ready
+    };
+
+    struct Slot
+    {
+        std::atomic<std::uint8_t> state{empty};
+        Del del;
+    };
+
+    struct Table
+    {
+        alignas(64) std::atomic<std::uint32_t> writers{0};
+        std::atomic<std::uint32_t> reserved{0};
+        std::atomic<std::uint32_t> used{0};
+        std::array<std::uint32_t, N> order{};
+        std::array<Slot, slotCount> slots{};
+    };
+
+    // Register as writer on the active table. Retry if flush switched
+    // tables in between.
+    Table* enter() noexcept
+    {
+        for (;;)
+        {
+            auto index = m_active.load(std::memory_order_acquire);
+            Table& table = m_tables[index];
+            table.writers.fetch_add(1, std::memory_order_seq_cst);
+            if (m_active.load(std::memory_order_seq_cst) == index)
+                return &table;
+            table.writers.fetch_sub(1, std::memory_order_release);
+        }
+    }
+
+    // Reserve room for one more unique delegate.
+    static bool reserve(Table& table) noexcept
+    {
+        if (table.reserved.fetch_add(1, std::memory_order_relaxed) < N)
+            return true;
+        table.reserved.fetch_sub(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    static bool insert(Table& table, const Del& del) noexcept
+    {
+        bool haveReservation = false;
+        auto pos = Del::hash(del);
+        for (std::size_t probe = 0; probe < slotCount; ++probe, ++pos)
+        {
+            Slot& slot = table.slots[pos & (slotCount - 1)];
+            auto state = slot.state.load(std::memory_order_acquire);
+            if (state == empty)
+            {
+                if (!haveReservation && !reserve(table))
+                    return false;
+                haveReservation = true;
+                if (slot.state.compare_exchange_strong(
+                        state, writing, std::memory_order_acquire))
+                {
+                    slot.del = del;
+                    auto i = table.used.fetch_add(1, std::memory_order_relaxed);
+                    table.order[i] = static_cast<std::uint32_t>(
+                        &slot - table.slots.data());
+                    slot.state.store(ready, std::memory_order_release);
+                    return true;
+                }
+            }
+            // Another producer is storing a delegate here. Wait to compare.
+            while (state == writing)
+            {
+                std::this_thread::yield();
+                state = slot.state.load(std::memory_order_acquire);
+            }
+            if (state == ready && slot.del == del)
+            {
+                if (haveReservation)
+                    table.reserved.fetch_sub(1, std::memory_order_relaxed);
+                return true;
+            }
+        }
+        if (haveReservation)
+            table.reserved.fetch_sub(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    std::array<Table, 2> m_tables{};
+    alignas(64) std::atomic<std::uint32_t> m_active{0};
+    std::atomic<std::size_t> m_dropped{0};
+};
+
+#endif /* DELEGATE_COALESCER_HPP_ */
@@ -0,0 +1,261 @@
+/*
+ * command_table.hpp
+ *
+ *  Created on: 18 oct. 2026
+ */
+
+#ifndef DELEGATE_COMMAND_TABLE_HPP_
+#define DELEGATE_COMMAND_TABLE_HPP_
+
+#include "delegate/delegate.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+/**
+ * Compile time lookup table from command names to delegates.
+ *
+ * The table is built by a constexpr function from a list of entries and
+ * uses a minimal perfect hash (hash and displace) of the names. A lookup is
+ * one pass over the name to hash it, two integer mixes for bucket and slot
+ * and one string compare. No heap allocation and no exceptions.
+ *
+ * Declare the table constexpr to have it placed in read only data:
+ *
+ *   using Del = delegate<void(int)>;
+ *   static constexpr auto table = make_command_table<void(int)>({
+ *       {"reset", Del::make<onReset>()},
+ *       {"stats", Del::make<onStats>()},
+ *   });
+ *   static_assert(table.ok(), "Duplicate command names");
+ *
+ *   table.find("reset")(1);
+ *
+ * Lookup of an unknown name return a null delegate, which is safe to call.
+ */
+
+#if __cplusplus < 201703L
+#error "Require at least C++17 to compile command_table"
+#endif
+
+namespace details
+{
+// FNV-1a of the name. Only computed once per lookup.
+constexpr std::uint32_t
+commandHash(std::string_view s) noexcept
+{
+    std::uint32_t h = 2166136261u;
+    for (char c : s)
+    {
+        h ^= static_cast<std::uint8_t>(c);
+        h *= 16777619u;
+    }
+    return h;
+}
+
+// Mix the name hash with 'seed' to select an independent hash function.
+constexpr std::uint32_t
+commandMix(std::uint32_t h, std::uint32_t seed) noexcept
+{
+    h ^= seed * 0x9e3779b9u;
+    h ^= h >> 16;
+    h *= 0x7feb352du;
+    h ^= h >> 15;
+    h *= 0x846ca68bu;
+    h ^= h >> 16;
+    return h;
+}
+
+// Bucket displacement marking a bucket with a single key placed directly.
+constexpr std::uint32_t directSlotFlag = 0x80000000u;
+
+// Give up on a bucket after this many seeds. Only happens for degenerate
+// input.
+constexpr std::uint32_t maxSeedTries = 1u << 16;
+} // namespace details
+
+template <typename Sig>
+struct command_entry
+{
+    std::string_view name;
+    delegate<Sig> del;
+};
+
+template <typename Sig, std::size_t N>
+class command_table
+{
+    static_assert(N > 0, "command_table require at least one entry");
+
+  public:
+    using Del = delegate<Sig>;
+
+    constexpr command_table() = default;
+
+    // Return the delegate stored for 'name' or a null delegate.
+    constexpr Del find(std::string_view name) const noexcept
+    {
+        auto slot = slotOf(name);
+        return m_entries[slot].name == name ? m_entries[slot].del : Del{};
+    }
+
+    constexpr bool contains(std::string_view name) const noexcept
+    {
+        return m_entries[slotOf(name)].name == name;
+    }
+
+    // False if the entries contained duplicate names.
+    constexpr bool ok() const noexcept
+    {
+        return m_ok;
+    }
+
+    static constexpr std::size_t size() noexcept
+    {
+        return N;
+    }
+
+    // Entries in slot order.
+    constexpr const command_entry<Sig>* begin() const noexcept
+    {
+        return m_entries.data();
+    }
+    constexpr const command_entry<Sig>* end() const noexcept
+    {
+        return m_entries.data() + N;
+    }
+
+  private:
+    template <typename S, std::size_t M>
+    friend constexpr command_table<S, M>
+    make_command_table(const std::array<command_entry<S>, M>&) noexcept;
+
+    static constexpr std::size_t bucketOf(std::uint32_t h) noexcept
+    {
+        return details::commandMix(h, 0) % N;
+    }
+
+    static constexpr std::size_t slotOf(std::uint32_t h,
+                                        std::uint32_t d) noexcept
+    {
+        if (d & details::directSlotFlag)
+            return d & ~details::directSlotFlag;
+        return details::commandMix(h, d) % N;
+    }
+
+    constexpr std::size_t slotOf(std::string_view name) const noexcept
+    {
+        auto h = details::commandHash(name);
+        return slotOf(h, m_displacement[bucketOf(h)]);
+    }
+
+    std::array<std::uint32_t, N> m_displacement{};
+    std::array<command_entry<Sig>, N> m_entries{};
+    bool m_ok = false;
+};
+
+/**
+ * Build a command_table. Check the result with 'ok()', preferably in a
+ * static_assert.
+ */
+template <typename Sig, std::size_t N>
+constexpr command_table<Sig, N>
+make_command_table(const std::array<command_entry<Sig>, N>& entries) noexcept
+{
+    using Table = command_table<Sig, N>;
+    Table table;
+
+    std::array<std::uint32_t, N> hash{};
+    for (std::size_t i = 0; i < N; ++i)
+        hash[i] = details::commandHash(entries[i].name);
+
+    // Sort entry indexes on bucket (counting sort).
+    std::array<std::size_t, N + 1> start{};
+    std::array<std::size_t, N> order{};
+    std::size_t maxSize = 0;
+    for (std::size_t i = 0; i < N; ++i)
+        ++start[Table::bucketOf(hash[i]) + 1];
+    for (std::size_t b = 0; b < N; ++b)
+    {
+        if (start[b + 1] > maxSize)
+            maxSize = start[b + 1];
+        start[b + 1] += start[b];
+    }
+    std::array<std::size_t, N> fill{};
+    for (std::size_t i = 0; i < N; ++i)
+    {
+        auto b = Table::bucketOf(hash[i]);
+        order[start[b] + fill[b]++] = i;
+    }
+
+    // Place the largest buckets first while the table is mostly empty.
+    std::array<bool, N> used{};
+    std::array<std::size_t, N> slots{};
+    for (std::size_t bucketSize = maxSize; bucketSize > 1; --bucketSize)
+    {
+        for (std::size_t b = 0; b < N; ++b)
+        {
+            if (start[b + 1] - start[b] != bucketSize)
+                continue;
+
+            for (std::size_t i = start[b]; i < start[b + 1]; ++i)
+                for (std::size_t j = i + 1; j < start[b + 1]; ++j)
+                    if (entries[order[i]].name == entries[order[j]].name)
+                        return table;
+
+            std::uint32_t seed = 1;
+            for (; seed < details::maxSeedTries; ++seed)
+            {
+                bool fits = true;
+                for (std::size_t i = 0; fits && i < bucketSize; ++i)
+                {
+                    slots[i] = Table::slotOf(hash[order[start[b] + i]], seed);
+                    fits = !used[slots[i]];
+                    for (std::size_t j = 0; fits && j < i; ++j)
+                        fits = slots[j] != slots[i];
+                }
+                if (fits)
+                    break;
+            }
+            if (seed == details::maxSeedTries)
+                return table;
+
+            table.m_displacement[b] = seed;
+            for (std::size_t i = 0; i < bucketSize; ++i)
+            {
+                used[slots[i]] = true;
+                table.m_entries[slots[i]] = entries[order[start[b] + i]];
+            }
+        }
+    }
+
+    // Single key buckets go straight into any free slot.
+    std::size_t freeSlot = 0;
+    for (std::size_t b = 0; b < N; ++b)
+    {
+        if (start[b + 1] - start[b] != 1)
+            continue;
+        while (used[freeSlot])
+            ++freeSlot;
+        used[freeSlot] = true;
+        table.m_displacement[b] =
+            details::directSlotFlag | static_cast<std::uint32_t>(freeSlot);
+        table.m_entries[freeSlot] = entries[order[start[b]]];
+    }
+
+    table.m_ok = true;
+    return table;
+}
+
+template <typename Sig, std::size_t N>
+constexpr command_table<Sig, N>
+make_command_table(const command_entry<Sig> (&entries)[N]) noexcept
+{
+    std::array<command_entry<Sig>, N> arr{};
+    for (std::size_t i = 0; i < N; ++i)
+        arr[i] = entries[i];
+    return make_command_table(arr);
+}
+
+#endif /* DELEGATE_COMMAND_TABLE_HPP_ */
@@ -0,0 +1,441 @@
+/*
+ * deferred_log.hpp
+ *
+ *  Created on: 18 oct. 2026
+ */
+
+#ifndef DELEGATE_DEFERRED_LOG_HPP_
+#define DELEGATE_DEFERRED_LOG_HPP_
+
+#include "delegate/buffer_invoke.hpp"
+#include "delegate/delegate.hpp"
+
+#include <atomic>
+#include <charconv>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+#include <unistd.h>
+
+/**
+ * Logger formatting on a background thread.
+ *
+ *   void orderLine(log_writer& w, int id, double price)
+ *   {
+ *       w << "order " << id << " at " << price << '\n';
+ *   }
+ *
+ *   deferred_logger logger{log_writer::Sink::make<&fd_sink::write>(out)};
+ *   logger.log<&orderLine>(id, price); // Hot path.
+ *
+ * The hot path copies the raw bytes of the arguments, and a formatter
+ * delegate<void(log_writer&, const void*)> decoding them, into a ring buffer
+ * owned by the calling thread. Nothing is formatted and no lock is taken.
+ * The background thread runs the formatters into a log_writer and hands the
+ * text to the sink in large batches.
+ *
+ * Arguments must be trivially copyable. Pointers are copied, not what they
+ * point to: only pass strings with static storage, like literals.
+ *
+ * Each thread logging gets one of 'maxThreads' rings on its first call,
+ * kept for the lifetime of the logger. A thread id reused by the system
+ * reuse the same ring. When the ring is full, or no ring is left, the
+ * record is dropped and 'log' return false.
+ */
+
+#if __cplusplus < 201703L
+#error "Require at least C++17 to compile deferred_log"
+#endif
+
+/**
+ * Text buffer handed to formatters. Pass its content to the sink when full
+ * and on 'flush'.
+ */
+class log_writer
+{
+  public:
+    using Sink = delegate<void(const char*, std::size_t)>;
+
+    explicit log_writer(Sink sink, std::size_t capacity = 64 * 1024)
+        : m_sink(sink), m_buf(new char[capacity]), m_capacity(capacity)
+    {
+    }
+
+    void write(const char* data, std::size_t size)
+    {
+        if (m_size + size > m_capacity)
+        {
+            flush();
+            if (size > m_capacity)
+            {
+                m_sink(data, size);
+                return;
+            }
+        }
+        std::memcpy(m_buf.get() + m_size, data, size);
+        m_size += size;
+    }
+
+    void flush()
+    {
+        if (m_size != 0)
+            m_sink(m_buf.get(), m_size);
+        m_size = 0;
+    }
+
+    log_writer& operator<<(std::string_view s)
+    {
+        write(s.data(), s.size());
+        return *this;
+    }
+
+    log_writer& operator<<(const char* s)
+    {
+        return *this << std::string_view(s);
+    }
+
+    log_writer& operator<<(char c)
+    {
+        write(&c, 1);
+        return *this;
+    }
+
+    template <typename T,
+              typename = std::enable_if_t<std::is_arithmetic<T>::value>>
+    log_writer& operator<<(T v)
+    {
+        char tmp[32];
+        auto res = std::to_chars(tmp, tmp + sizeof(tmp), v);
+        write(tmp, static_cast<std::size_t>(res.ptr - tmp));
+        return *this;
+    }
+
+  private:
+    Sink m_sink;
+    std::unique_ptr<char[]> m_buf;
+    std::size_t m_capacity;
+    std::size_t m_size = 0;
+};
+
+// Sink writing to a file descriptor.
+struct fd_sink
+{
+    void write(const char* data, std::size_t size)
+    {
+        while (size != 0)
+        {
+            auto n = ::write(fd, data, size);
+            if (n <= 0)
+                return;
+            data += n;
+            size -= static_cast<std::size_t>(n);
+        }
+    }
+    int fd;
+};
+
+namespace details
+{
+using LogFormatter = delegate<void(log_writer&, const void*)>;
+
+static_assert(std::is_trivially_copyable<LogFormatter>::value,
+              "Formatters are copied into the ring with memcpy");
+
+struct LogHeader
+{
+    LogFormatter format;
+    std::uint32_t size; // Payload bytes, 'logPadding' to skip to the end.
+};
+
+constexpr std::uint32_t logPadding = ~std::uint32_t{0};
+constexpr std::size_t logAlign = alignof(LogHeader);
+
+constexpr std::size_t
+logRecordSize(std::size_t payload) noexcept
+{
+    return (sizeof(LogHeader) + payload + logAlign - 1) / logAlign * logAlign;
+}
+
+template <auto fmt, typename... Args, std::size_t... I>
+void
+formatLogArgs(log_writer& w, const std::byte* raw, std::index_sequence<I...>)
+{
+    constexpr auto offsets = callOffsets<packed_layout, Args...>();
+    fmt(w, loadArg<Args>(raw + offsets[I])...);
+}
+
+// Formatter of a record, arguments are in the buffer_invoke packed layout.
+template <auto fmt, typename... Args>
+void
+formatLog(log_writer& w, const void* raw)
+{
+    formatLogArgs<fmt, Args...>(w, static_cast<const std::byte*>(raw),
+                                std::index_sequence_for<Args...>{});
+}
+
+// Single producer single consumer ring of variable size records.
+struct LogRing
+{
+    alignas(64) std::atomic<std::uint64_t> head{0};
+    std::uint64_t cachedTail = 0;
+    alignas(64) std::atomic<std::uint64_t> tail{0};
+    alignas(64) std::atomic<std::thread::id> owner{};
+    std::unique_ptr<std::byte[]> buf;
+    std::size_t capacity = 0;
+
+    // Producer. Return a payload area of 'payload' bytes, or nullptr if full.
+    std::byte* reserve(const LogFormatter& format, std::size_t payload)
+    {
+        auto size = logRecordSize(payload);
+        auto pos = head.load(std::memory_order_relaxed);
+        auto off = pos % capacity;
+        std::size_t pad = off + size > capacity ? capacity - off : 0;
+        if (pos + pad + size - cachedTail > capacity)
+        {
+            cachedTail = tail.load(std::memory_order_acquire);
+            if (pos + pad + size - cachedTail > capacity)
+                return nullptr;
+        }
+        if (pad >= sizeof(LogHeader))
+            writeHeader(off, LogFormatter{}, logPadding);
+        off = (pos + pad) % capacity;
+        writeHeader(off, format, static_cast<std::uint32_t>(payload));
+        m_pending = pos + pad + size;
+        return buf.get() + off + sizeof(LogHeader);
+    }
+
+    // Producer. Make the record returned by 'reserve' visible.
+    void commit()
+    {
+        head.store(m_pending, std::memory_order_release);
+    }
+
+    // Consumer. Run all available records, return their number.
+    std::size_t consume(log_writer& w)
+    {
+        std::size_t n = 0;
+        auto pos = tail.load(std::memory_order_relaxed);
+        auto end = head.load(std::memory_order_acquire);
+        while (pos != end)
+        {
+            auto off = pos % capacity;
+            if (capacity - off < sizeof(LogHeader))
+            {
+                pos += capacity - off;
+                continue;
+            }
+            LogHeader h;
+            std::memcpy(&h, buf.get() + off, sizeof(h));
+            if (h.size == logPadding)
+            {
+                pos += capacity - off;
+                continue;
+            }
+            h.format(w, buf.get() + off + sizeof(LogHeader));
+            pos += logRecordSize(h.size);
+            ++n;
+        }
+        tail.store(pos, std::memory_order_release);
+        return n;
+    }
+
+  private:
+    void writeHeader(std::size_t off, const LogFormatter& format,
+                     std::uint32_t size)
+    {
+        LogHeader h{format, size};
+        std::memcpy(buf.get() + off, &h, sizeof(h));
+    }
+
+    std::uint64_t m_pending = 0;
+};
+} // namespace details
+
+class deferred_logger
+{
+  public:
+    using Sink = log_writer::Sink;
+
+    /**
+     * 'ringBytes' is the ring size of each thread, rounded up to a multiple
+     * of the record alignment.
+     */
+    explicit deferred_logger(Sink sink, std::size_t maxThreads = 64,
+                             std::size_t ringBytes = 64 * 1024)
+        : m_writer(sink), m_rings(new details::LogRing[maxThreads]),
+          m_maxThreads(maxThreads), m_id(nextId())
+    {
+        constexpr auto align = details::logAlign;
+        ringBytes = (ringBytes + align - 1) / align * align;
+        for (std::size_t i = 0; i < maxThreads; ++i)
+        {
+            m_rings[i].buf.reset(new std::byte[ringBytes]);
+            m_rings[i].capacity = ringBytes;
+        }
+        m_thread = std::thread([this] { run(); });
+    }
+
+    deferred_logger(const deferred_logger&) = delete;
+    deferred_logger& operator=(const deferred_logger&) = delete;
+
+    // Write everything logged so far, then stop the background thread.
+    ~deferred_logger()
+    {
+        m_stop.store(true, std::memory_order_release);
+        m_thread.join();
+    }
+
+    /**
+     * Queue a call of 'fmt(writer, args...)' on the background thread.
+     * Return false if the record was dropped.
+     */
+    template <auto fmt, typename... A>
+    bool log(const A&... args)
+    {
+        // String literals are stored as pointers.
+        return push<fmt, std::decay_t<const A&>...>(args...);
+    }
+
+    /**
+     * Block until everything logged before the call, by any thread, was
+     * handed to the sink.
+     */
+    void flush()
+    {
+        auto count = m_ringCount.load(std::memory_order_acquire);
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            auto target = m_rings[i].head.load(std::memory_order_acquire);
+            while (m_rings[i].tail.load(std::memory_order_acquire) < target)
+                std::this_thread::yield();
+        }
+        // The pass that consumed the records pass them to the sink before
+        // counting itself.
+        auto pass = m_passes.load(std::memory_order_acquire);
+        while (m_passes.load(std::memory_order_acquire) < pass + 1)
+            std::this_thread::yield();
+    }
+
+    std::size_t dropped() const noexcept
+    {
+        return m_dropped.load(std::memory_order_relaxed);
+    }
+
+  private:
+    template <auto fmt, typename... Ts>
+    bool push(const Ts&... args)
+    {
+        using Codec = details::CallCodec<packed_layout, void(Ts...)>;
+        constexpr auto formatFkn = &details::formatLog<fmt, Ts...>;
+        auto format = details::LogFormatter::make<formatFkn>();
+        details::LogRing* ring = threadRing();
+        std::byte* payload = nullptr;
+        if (ring)
+            payload = ring->reserve(format, Codec::size);
+        if (!payload)
+        {
+            m_dropped.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        Codec::encode(payload, Codec::size, args...);
+        ring->commit();
+        return true;
+    }
+
+    // Ring last used by a thread, and the id of its logger.
+    struct ThreadCache
+    {
+        std::uint64_t logger = 0;
+        details::LogRing* ring = nullptr;
+    };
+
+    static ThreadCache& threadCache() noexcept
+    {
+        thread_local ThreadCache cache;
+        return cache;
+    }
+
+    // Unique for the process, so a logger created at the address of a
+    // destroyed one does not match its cache entries.
+    static std::uint64_t nextId() noexcept
+    {
+        static std::atomic<std::uint64_t> last{0};
+        return last.fetch_add(1, std::memory_order_relaxed) + 1;
+    }
+
+    // Ring of the calling thread. Only the first call of a thread, or after
+    // using another logger, searches the rings.
+    details::LogRing* threadRing() noexcept
+    {
+        ThreadCache& cache = threadCache();
+        if (cache.logger == m_id)
+            return cache.ring;
+        auto ring = findRing();
+        if (ring)
+            cache = ThreadCache{m_id, ring};
+        return ring;
+    }
+
+    // Ring owned by the calling thread, claimed if none.
+    details::LogRing* findRing() noexcept
+    {
+        auto self = std::this_thread::get_id();
+        auto count = m_ringCount.load(std::memory_order_acquire);
+        for (std::size_t i = 0; i < count; ++i)
+            if (m_rings[i].owner.load(std::memory_order_relaxed) == self)
+                return &m_rings[i];
+
+        auto index = m_claimed.fetch_add(1, std::memory_order_relaxed);
+        if (index >= m_maxThreads)
+            return nullptr;
+        m_rings[index].owner.store(self, std::memory_order_relaxed);
+        // Publish in order, a slower thread may hold a lower index.
+        auto expected = index;
+        while (!m_ringCount.compare_exchange_weak(expected, index + 1,
+                                                  std::memory_order_release))
+        {
+            expected = index;
+            std::this_thread::yield();
+        }
+        return &m_rings[index];
+    }
+
+    void run()
+    {
+        using namespace std::chrono_literals;
+        for (;;)
+        {
+            bool stop = m_stop.load(std::memory_order_acquire);
+            std::size_t n = 0;
+            auto count = m_ringCount.load(std::memory_order_acquire);
+            for (std::size_t i = 0; i < count; ++i)
+                n += m_rings[i].consume(m_writer);
+            m_writer.flush();
+            m_passes.fetch_add(1, std::memory_order_release);
+            if (stop)
+                return;
+            if (n == 0)
+                std::this_thread::sleep_for(100us);
+        }
+    }
+
+    log_writer m_writer;
+    std::unique_ptr<details::LogRing[]> m_rings;
+    std::size_t m_maxThreads;
+    std::uint64_t m_id;
+    std::atomic<std::size_t> m_claimed{0};
+    std::atomic<std::size_t> m_ringCount{0};
+    std::atomic<std::size_t> m_dropped{0};
+    std::atomic<std::uint64_t> m_passes{0};
+    std::atomic<bool> m_stop{false};
+    std::thread m_thread;
+};
+
+#endif /* DELEGATE_DEFERRED_LOG_HPP_ */
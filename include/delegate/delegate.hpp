@@ -8,8 +8,15 @@
 #ifndef DELEGATE_DELEGATE_HPP_
 #define DELEGATE_DELEGATE_HPP_
 
-#include <cstddef> // nullptr_t
-#include <cstdint> // uintptr_t
+#include <cstddef>     // nullptr_t
+#include <cstdint>     // uintptr_t
+#include <cstdlib>     // abort
+#include <type_traits> // enable_if
+#include <utility>     // declval
+
+#if __cplusplus >= 201703L
+#include <optional>
+#endif
 
 /**
  * Simple storage of a callable object for functors, free and member functions.
@@ -67,6 +74,17 @@
  *
  * The delegate do not allow storing pointers to r-value references
  * (temporary objects) for member and functor construction.
+ *
+ * Defining DELEGATE_FOLD_TRAMPOLINES makes delegates to free functions, and
+ * in C++17 to stateless functors such as lambdas without capture, store the
+ * function pointer and share one trampoline per signature. Smaller code, at
+ * the cost of an indirect call the compiler can no longer inline through.
+ * Two such delegates compare equal when they call the same function.
+ *
+ * Defining DELEGATE_LEAN keeps the same API, but in C++17 the
+ * 'set<&T::f>'/'make<&T::f>' overloads deduce the object type from the
+ * member function type alone. All targets of one type share that work
+ * instead of each instantiating DeduceMemberType.
  */
 
 #if __cplusplus < 201103L
@@ -83,18 +101,144 @@ namespace details
 {
 template <typename T>
 T
-nullReturnFunction()
+nullReturnFunction(std::true_type)
 {
     return T{};
 }
+
+// No default value to return. Use try_call for these types.
+template <typename T>
+T
+nullReturnFunction(std::false_type)
+{
+    std::abort();
+}
+
+template <typename T>
+T
+nullReturnFunction()
+{
+    return nullReturnFunction<T>(std::is_default_constructible<T>{});
+}
 template <>
-void
+inline void
 nullReturnFunction()
 {
     return;
 }
+
+// Null check of a function given as template argument. Done through a
+// parameter, so compilers do not warn that the address is never null.
+template <typename F>
+constexpr bool
+isNullFkn(F fkn) noexcept
+{
+    return fkn == nullptr;
+}
+
+// How trampolines pass an argument of the signature on. Rvalue references
+// as rvalues, anything else as an lvalue, so a functor taking 'T&' still
+// binds to a by-value 'T' parameter.
+template <typename T>
+struct PassArg
+{
+    using type = T&;
+};
+
+template <typename T>
+struct PassArg<T&&>
+{
+    using type = T&&;
+};
+
+template <typename... Ts>
+struct MakeVoid
+{
+    using type = void;
+};
+
+// True if 'F' can be called with 'Args', passed as trampolines do, and its
+// result converts to 'R'.
+template <typename Sig, typename F, typename = void>
+struct IsCallableAs : std::false_type
+{
+};
+
+template <typename F, typename... Args>
+using CallResult = decltype(std::declval<F>()(
+    std::declval<typename PassArg<Args>::type>()...));
+
+template <typename R, typename... Args, typename F>
+struct IsCallableAs<R(Args...), F,
+                    typename MakeVoid<CallResult<F, Args...>>::type>
+    : std::integral_constant<
+          bool, std::is_void<R>::value ||
+                    std::is_convertible<CallResult<F, Args...>, R>::value>
+{
+};
+
+#if __cplusplus >= 201703L
+template <typename T>
+struct TryCallResult
+{
+    using type = std::optional<T>;
+};
+
+// Void delegates report if the call was made.
+template <>
+struct TryCallResult<void>
+{
+    using type = bool;
+};
+#endif
 } // namespace details
 
+/**
+ * What calling a null delegate with signature 'Sig' does. The default
+ * return a value initialized R, or abort if R can't be default constructed.
+ *
+ * Specialize it, before the delegate type is used, to change the behavior
+ * for one signature. Only the null trampoline call 'on_null', the normal
+ * call path is unchanged.
+ *
+ *   // Abort instead of returning 0.
+ *   template <>
+ *   struct delegate_null_policy<int(int)> : delegate_null_trap<int(int)>
+ *   {
+ *   };
+ *
+ *   // Custom default.
+ *   template <>
+ *   struct delegate_null_policy<Color()>
+ *   {
+ *       static Color on_null() { return Color::magenta; }
+ *   };
+ */
+template <typename T>
+struct delegate_null_policy;
+
+template <typename R, typename... Args>
+struct delegate_null_policy<R(Args...)>
+{
+    static R on_null(Args...)
+    {
+        return details::nullReturnFunction<R>();
+    }
+};
+
+// Null policy aborting the program.
+template <typename T>
+struct delegate_null_trap;
+
+template <typename R, typename... Args>
+struct delegate_null_trap<R(Args...)>
+{
+    [[noreturn]] static R on_null(Args...)
+    {
+        std::abort();
+    }
+};
+
 template <typename T>
 class delegate;
 
@@ -120,7 +264,9 @@ class MemFkn
     // It will vary randomly depending on where symbols end up etc.
     static constexpr bool less(const MemFkn& lhs, const MemFkn& rhs) noexcept
     {
-        return (lhs.null() && !rhs.null()) || lhs.trampoline < rhs.trampoline;
+        // Null first, whatever the address of doNullFkn.
+        return lhs.null() != rhs.null() ? lhs.null()
+                                        : lhs.trampoline < rhs.trampoline;
     }
 
     // Return true if a function pointer is stored.
@@ -164,10 +310,14 @@ class delegate<R_(Args...)>
     // Type of the function pointer for the trampoline functions.
     using Trampoline = R (*)(DataPtr const&, Args...);
 
+    template <typename T>
+    using Pass = typename details::PassArg<T>::type;
+
     // Adaptor function for when the delegate is expected to be a nullptr.
     inline static R doNullFkn(DataPtr const& v, Args... args)
     {
-        return details::nullReturnFunction<R>();
+        return delegate_null_policy<R(Args...)>::on_null(
+            static_cast<Pass<Args>>(args)...);
     }
 
     // Adaptor function for the case where void* is not forwarded
@@ -175,7 +325,7 @@ class delegate<R_(Args...)>
     template <R(freeFkn)(Args...)>
     inline static R doFreeCB(DataPtr const& v, Args... args)
     {
-        return freeFkn(args...);
+        return freeFkn(static_cast<Pass<Args>>(args)...);
     }
 
     // Adapter function for the member + object calling.
@@ -183,7 +333,7 @@ class delegate<R_(Args...)>
     inline static R doMemberCB(DataPtr const& o, Args... args)
     {
         T* obj = static_cast<T*>(o.v_ptr);
-        return (((*obj).*(memFkn))(args...));
+        return (((*obj).*(memFkn))(static_cast<Pass<Args>>(args)...));
     }
 
     // Adapter function for the member + object calling.
@@ -191,7 +341,7 @@ class delegate<R_(Args...)>
     inline static R doConstMemberCB(DataPtr const& o, Args... args)
     {
         T const* obj = static_cast<T const*>(o.v_ptr);
-        return (((*obj).*(memFkn))(args...));
+        return (((*obj).*(memFkn))(static_cast<Pass<Args>>(args)...));
     }
 
     // Adapter function for when the stored object is a pointer to a
@@ -200,20 +350,20 @@ class delegate<R_(Args...)>
     inline static R doFunctor(DataPtr const& o_arg, Args... args)
     {
         auto obj = static_cast<Functor*>(o_arg.v_ptr);
-        return (*obj)(args...);
+        return (*obj)(static_cast<Pass<Args>>(args)...);
     }
 
     template <class Functor>
     inline static R doConstFunctor(DataPtr const& o_arg, Args... args)
     {
         const Functor* obj = static_cast<Functor const*>(o_arg.v_ptr);
-        return (*obj)(args...);
+        return (*obj)(static_cast<Pass<Args>>(args)...);
     }
 
     inline static R doRuntimeFkn(DataPtr const& o_arg, Args... args)
     {
         TargetFreeCB fkn = o_arg.fkn_ptr;
-        return fkn(args...);
+        return fkn(static_cast<Pass<Args>>(args)...);
     }
 
     // Adapter function for the free function with extra first arg
@@ -222,7 +372,7 @@ class delegate<R_(Args...)>
     inline static R dofreeFknWithObjectRef(DataPtr const& o, Args... args)
     {
         T* obj = static_cast<T*>(o.v_ptr);
-        return freeFkn(*obj, args...);
+        return freeFkn(*obj, static_cast<Pass<Args>>(args)...);
     }
 
     // Adapter function for the free function with extra first arg
@@ -231,9 +381,20 @@ class delegate<R_(Args...)>
     inline static R dofreeFknWithObjectConstRef(DataPtr const& o, Args... args)
     {
         T const* obj = static_cast<const T*>(o.v_ptr);
-        return freeFkn(*obj, args...);
+        return freeFkn(*obj, static_cast<Pass<Args>>(args)...);
     }
 
+#if defined(DELEGATE_FOLD_TRAMPOLINES) && __cplusplus >= 201703L
+    // Functors without state and convertible to a function pointer, like
+    // lambdas without capture, are stored as that function pointer.
+    template <class T>
+    static constexpr bool foldFunctor() noexcept
+    {
+        return std::is_empty<T>::value &&
+               std::is_convertible<T const&, TargetFreeCB>::value;
+    }
+#endif
+
   public:
     // Default construct with stored ptr == nullptr.
     constexpr delegate(const std::nullptr_t& nptr = nullptr) noexcept
@@ -245,9 +406,48 @@ class delegate<R_(Args...)>
     // Will call trampoline fkn which will call the final fkn.
     constexpr R operator()(Args... args) const __attribute__((always_inline))
     {
-        return m_cb(m_ptr, args...);
+        return m_cb(m_ptr, static_cast<Pass<Args>>(args)...);
+    }
+
+    /**
+     * Call unless null and store the result in 'out'. Return false,
+     * leaving 'out' untouched, if null.
+     */
+    template <typename Res = R>
+    DELEGATE_CXX14CONSTEXPR bool try_call_into(Res& out, Args... args) const
+    {
+        if (null())
+            return false;
+        out = m_cb(m_ptr, static_cast<Pass<Args>>(args)...);
+        return true;
     }
 
+#if __cplusplus >= 201703L
+    /**
+     * Call unless null. Return the result as an optional, empty if null, so
+     * no R is constructed for nothing. Void delegates return true if
+     * called.
+     */
+    template <typename Res = R>
+    constexpr typename details::TryCallResult<Res>::type
+    try_call(Args... args) const
+    {
+        if constexpr (std::is_void<Res>::value)
+        {
+            if (null())
+                return false;
+            m_cb(m_ptr, static_cast<Pass<Args>>(args)...);
+            return true;
+        }
+        else
+        {
+            if (null())
+                return std::nullopt;
+            return m_cb(m_ptr, static_cast<Pass<Args>>(args)...);
+        }
+    }
+#endif
+
     constexpr bool null() const noexcept
     {
         return m_cb == doNullFkn;
@@ -286,13 +486,14 @@ class delegate<R_(Args...)>
                                const delegate& rhs) noexcept
     {
         // Ugly, but the m_ptr part should be optimized away on normal
-        // platforms.
-        return (lhs.null() && !rhs.null()) //
-               || lhs.m_cb < rhs.m_cb      //
-               || (lhs.m_cb == rhs.m_cb &&
-                   (lhs.m_cb == doRuntimeFkn
-                        ? (lhs.m_ptr.fkn_ptr < rhs.m_ptr.fkn_ptr)
-                        : (lhs.m_ptr.v_ptr < rhs.m_ptr.v_ptr)));
+        // platforms. Null first, whatever the address of doNullFkn.
+        return lhs.null() != rhs.null()
+                   ? lhs.null()
+                   : (lhs.m_cb < rhs.m_cb ||
+                      (lhs.m_cb == rhs.m_cb &&
+                       (lhs.m_cb == doRuntimeFkn
+                            ? (lhs.m_ptr.fkn_ptr < rhs.m_ptr.fkn_ptr)
+                            : (lhs.m_ptr.v_ptr < rhs.m_ptr.v_ptr))));
     }
 
     constexpr bool less(const delegate& rhs) const noexcept
@@ -310,6 +511,26 @@ class delegate<R_(Args...)>
         }
     };
 
+    // Hash consistent with 'equal', for use in unordered containers.
+    static std::size_t hash(const delegate& d) noexcept
+    {
+        auto cb = reinterpret_cast<std::uintptr_t>(d.m_cb);
+        auto ptr = d.m_cb == doRuntimeFkn
+                       ? reinterpret_cast<std::uintptr_t>(d.m_ptr.fkn_ptr)
+                       : reinterpret_cast<std::uintptr_t>(d.m_ptr.v_ptr);
+        return static_cast<std::size_t>(ptr ^ (cb + 0x9e3779b9u + (ptr << 6) +
+                                               (ptr >> 2)));
+    }
+
+    // Helper Functor for passing into std::unordered_set et.al.
+    struct Hash
+    {
+        std::size_t operator()(const delegate& d) const noexcept
+        {
+            return hash(d);
+        }
+    };
+
     // Return true if a function pointer is stored.
     constexpr explicit operator bool() const noexcept
     {
@@ -322,6 +543,33 @@ class delegate<R_(Args...)>
         m_ptr.v_ptr = nullptr;
     }
 
+    /**
+     * Address of the object or functor called into, or of the user pointer
+     * given to makeVoidCB. Nullptr for free functions, whose slot holds no
+     * object or a function pointer.
+     */
+    constexpr const void* context() const noexcept
+    {
+        return m_cb == doRuntimeFkn ? nullptr : m_ptr.v_ptr;
+    }
+
+    /**
+     * For relocation of objects. If 'context' is in
+     * [oldBase, oldBase + length), move it by newBase - oldBase and return
+     * true. Other delegates are not changed.
+     */
+    bool rebase(const void* oldBase, const void* newBase,
+                std::size_t length) noexcept
+    {
+        auto ctx = reinterpret_cast<std::uintptr_t>(context());
+        auto from = reinterpret_cast<std::uintptr_t>(oldBase);
+        if (ctx == 0 || ctx < from || ctx - from >= length)
+            return false;
+        auto to = reinterpret_cast<std::uintptr_t>(newBase);
+        m_ptr.v_ptr = reinterpret_cast<void*>(to + (ctx - from));
+        return true;
+    }
+
     /**
      * Create a callback to a free function with a specific type on
      * the pointer.
@@ -329,8 +577,12 @@ class delegate<R_(Args...)>
     template <R (*fkn)(Args... args)>
     DELEGATE_CXX14CONSTEXPR delegate& set() noexcept
     {
-        m_cb = fkn ? &doFreeCB<fkn> : &doNullFkn;
+#ifdef DELEGATE_FOLD_TRAMPOLINES
+        *this = make<fkn>();
+#else
+        m_cb = details::isNullFkn(fkn) ? &doNullFkn : &doFreeCB<fkn>;
         m_ptr.v_ptr = nullptr;
+#endif
         return *this;
     }
 
@@ -369,6 +621,10 @@ class delegate<R_(Args...)>
     template <class T>
     DELEGATE_CXX14CONSTEXPR delegate& set(T& tr) noexcept
     {
+#if defined(DELEGATE_FOLD_TRAMPOLINES) && __cplusplus >= 201703L
+        if constexpr (foldFunctor<T>())
+            return set(static_cast<TargetFreeCB>(tr));
+#endif
         m_cb = &doFunctor<T>;
         m_ptr.v_ptr = static_cast<void*>(&tr);
         return *this;
@@ -377,6 +633,10 @@ class delegate<R_(Args...)>
     template <class T>
     DELEGATE_CXX14CONSTEXPR delegate& set(T const& tr) noexcept
     {
+#if defined(DELEGATE_FOLD_TRAMPOLINES) && __cplusplus >= 201703L
+        if constexpr (foldFunctor<T>())
+            return set(static_cast<TargetFreeCB>(tr));
+#endif
         m_cb = &doConstFunctor<T>;
         m_ptr.v_ptr = const_cast<void*>(static_cast<const void*>(&tr));
         return *this;
@@ -405,8 +665,13 @@ class delegate<R_(Args...)>
     template <R (*fkn)(Args... args)>
     static constexpr delegate make() noexcept
     {
-        return delegate{fkn ? &doFreeCB<fkn> : &doNullFkn,
+#ifdef DELEGATE_FOLD_TRAMPOLINES
+        return details::isNullFkn(fkn) ? delegate{}
+                                       : delegate{&doRuntimeFkn, fkn};
+#else
+        return delegate{details::isNullFkn(fkn) ? &doNullFkn : &doFreeCB<fkn>,
                         static_cast<void*>(nullptr)};
+#endif
     }
 
     /**
@@ -434,11 +699,19 @@ class delegate<R_(Args...)>
     template <class T>
     static constexpr delegate make(T& o) noexcept
     {
+#if defined(DELEGATE_FOLD_TRAMPOLINES) && __cplusplus >= 201703L
+        if constexpr (foldFunctor<T>())
+            return delegate{&doRuntimeFkn, static_cast<TargetFreeCB>(o)};
+#endif
         return delegate{&doFunctor<T>, static_cast<void*>(&o)};
     }
     template <class T>
     static constexpr delegate make(T const& o) noexcept
     {
+#if defined(DELEGATE_FOLD_TRAMPOLINES) && __cplusplus >= 201703L
+        if constexpr (foldFunctor<T>())
+            return delegate{&doRuntimeFkn, static_cast<TargetFreeCB>(o)};
+#endif
         return delegate{&doConstFunctor<T>,
                         const_cast<void*>(static_cast<const void*>(&o))};
     }
@@ -607,7 +880,64 @@ class delegate<R_(Args...)>
 
     // C++17 allow template<auto> for non type template arguments.
     // Use to avoid specifying object type.
-#if __cplusplus >= 201703
+#if __cplusplus >= 201703 && defined(DELEGATE_LEAN)
+
+    // Keyed on the member function type only, so targets sharing a type
+    // share the instantiation. ObjType is const for const members, making
+    // one overload take both const and non const objects.
+    template <typename T>
+    struct MemberOf;
+
+    template <typename T>
+    struct MemberOf<R (T::*)(Args...)>
+    {
+        using ObjType = T;
+        static constexpr bool cnst = false;
+        template <R (T::*mf)(Args...)>
+        static constexpr Trampoline trampoline = &doMemberCB<T, mf>;
+    };
+    template <typename T>
+    struct MemberOf<R (T::*)(Args...) const>
+    {
+        using ObjType = T const;
+        static constexpr bool cnst = true;
+        template <R (T::*mf)(Args...) const>
+        static constexpr Trampoline trampoline = &doConstMemberCB<T, mf>;
+    };
+
+    template <auto mFkn>
+    constexpr delegate&
+    set(typename MemberOf<decltype(mFkn)>::ObjType& obj) noexcept
+    {
+        m_cb = MemberOf<decltype(mFkn)>::template trampoline<mFkn>;
+        m_ptr = const_cast<void*>(static_cast<const void*>(&obj));
+        return *this;
+    }
+    template <auto mFkn>
+    constexpr delegate&
+    set(typename MemberOf<decltype(mFkn)>::ObjType&& obj) = delete;
+
+    template <auto mFkn>
+    static constexpr delegate
+    make(typename MemberOf<decltype(mFkn)>::ObjType& obj) noexcept
+    {
+        return delegate{MemberOf<decltype(mFkn)>::template trampoline<mFkn>,
+                        &obj};
+    }
+
+    // Temoraries not allowed.
+    template <auto mFkn>
+    static constexpr delegate
+    make(typename MemberOf<decltype(mFkn)>::ObjType&&) = delete;
+
+    // MemFkn construction.
+    template <auto mFkn>
+    static constexpr auto memFkn() noexcept
+    {
+        using MO = MemberOf<decltype(mFkn)>;
+        return MemFkn<delegate, MO::cnst>{MO::template trampoline<mFkn>};
+    }
+#elif __cplusplus >= 201703
 
     template <auto mFkn>
     constexpr delegate&
@@ -671,7 +1001,7 @@ class delegate<R_(Args...)>
 
     // Create ordinary free function pointer callback.
     constexpr delegate(Trampoline cb, const void* ptr) noexcept
-        : m_cb(cb), m_ptr(ptr)
+        : m_cb(cb), m_ptr(const_cast<void*>(ptr))
     {
     }
 
@@ -751,6 +1081,83 @@ constexpr bool
 operator>=(const delegate<R(Args...)>& lhs,
            const delegate<R(Args...)>& rhs) = delete;
 
+/**
+ * Borrowed reference to a callable, intended as function parameter type.
+ *
+ *   void for_each_connection(delegate_ref<void(Connection&)> cb);
+ *   for_each_connection([&](Connection& c) { c.close(); });
+ *
+ * Unlike delegate, a delegate_ref binds to temporaries. A temporary lives
+ * until the end of the full expression, so the reference is valid for the
+ * duration of the call it is passed to. It must not be stored beyond that.
+ *
+ * It use the same trampolines as delegate, is two words and trivially
+ * copyable. A delegate converts implicitly to a delegate_ref.
+ */
+template <typename T>
+class delegate_ref;
+
+template <typename R, typename... Args>
+class delegate_ref<R(Args...)>
+{
+    using Del = delegate<R(Args...)>;
+
+    template <class F>
+    using Ref = typename std::remove_reference<F>::type&;
+
+    template <class F>
+    using Bare =
+        typename std::remove_cv<typename std::remove_reference<F>::type>::type;
+
+    template <class T>
+    using Pass = typename details::PassArg<T>::type;
+
+    // Object callable as R(Args...), not a delegate, delegate_ref or
+    // function.
+    template <class F>
+    using EnableFunctor = typename std::enable_if<
+        !std::is_same<Bare<F>, delegate_ref>::value &&
+        !std::is_same<Bare<F>, Del>::value &&
+        !std::is_function<Bare<F>>::value &&
+        !std::is_pointer<Bare<F>>::value &&
+        details::IsCallableAs<R(Args...), Ref<F>>::value>::type;
+
+  public:
+    constexpr delegate_ref(const Del& del) noexcept : m_del(del) {}
+
+    // Null, calling it behaves as calling a null delegate.
+    constexpr delegate_ref(std::nullptr_t) noexcept : m_del() {}
+
+    constexpr delegate_ref(R (*fkn)(Args...)) noexcept
+        : m_del(Del::make_fkn(fkn))
+    {
+    }
+
+    template <class F, class = EnableFunctor<F>>
+    constexpr delegate_ref(F&& f) noexcept
+        : m_del(Del::make(static_cast<Ref<F>>(f)))
+    {
+    }
+
+    constexpr R operator()(Args... args) const
+    {
+        return m_del(static_cast<Pass<Args>>(args)...);
+    }
+
+    constexpr bool null() const noexcept
+    {
+        return m_del.null();
+    }
+
+    constexpr explicit operator bool() const noexcept
+    {
+        return !null();
+    }
+
+  private:
+    Del m_del;
+};
+
 /**
  * Helper macro to create a delegate for calling a member function.
  * Example of use:
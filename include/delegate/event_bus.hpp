@@ -0,0 +1,288 @@
+/*
+ * event_bus.hpp
+ *
+ *  Created on: 18 oct. 2026
+ */
+
+#ifndef DELEGATE_EVENT_BUS_HPP_
+#define DELEGATE_EVENT_BUS_HPP_
+
+#include "delegate/delegate.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <tuple>
+#include <type_traits>
+#include <variant>
+
+/**
+ * Event bus where every event type is known at compile time.
+ *
+ *   using Events = event_list<KeyPressed, MouseMoved, WindowClosed>;
+ *   event_bus<Events, 16> bus;
+ *
+ *   auto h = bus.subscribe<KeyPressed>(
+ *       delegate<void(const KeyPressed&)>::make<&Editor::onKey>(editor));
+ *   bus.publish(KeyPressed{'a'});  // Owner thread, calls now.
+ *   bus.post(MouseMoved{10, 20});   // Any thread, queued.
+ *   bus.drain();                    // Owner thread, calls queued events.
+ *   bus.unsubscribe<KeyPressed>(h);
+ *
+ * Event types must be distinct. Each gets a dense id, its index in the
+ * event_list, and owns an inline array of up to PerEvent
+ * delegate<void(const E&)>. 'publish' selects the array at compile time and
+ * loops over it: no hashing, no type_index, no allocation, subscribing
+ * included.
+ *
+ * 'post' copies the event into a bounded lock-free queue of QueueSize
+ * entries, it fails when the queue is full. 'drain' publishes the queued
+ * events in posting order.
+ *
+ * Everything but 'post' must be called from one thread, the owner.
+ * Subscribers are called in subscription order. They may publish and post,
+ * but must not subscribe to or unsubscribe from the event type being
+ * published.
+ */
+
+#if __cplusplus < 201703L
+#error "Require at least C++17 to compile event_bus"
+#endif
+
+template <typename... Events>
+struct event_list
+{
+};
+
+namespace details
+{
+template <typename E, typename... Events>
+constexpr std::size_t
+eventIndex() noexcept
+{
+    constexpr bool match[] = {std::is_same<E, Events>::value...};
+    for (std::size_t i = 0; i < sizeof...(Events); ++i)
+        if (match[i])
+            return i;
+    return sizeof...(Events);
+}
+
+// Subscribers of one event type.
+template <typename E, std::size_t N>
+struct EventChannel
+{
+    std::size_t size = 0;
+    std::array<delegate<void(const E&)>, N> dels{};
+    std::array<std::uint32_t, N> ids{};
+};
+
+/**
+ * Vyukov bounded MPMC queue, used here with one consumer. Each cell has a
+ * sequence number telling whether it is free for the push at that position,
+ * or holds the value for the pop at that position.
+ */
+template <typename T, std::size_t N>
+class BoundedQueue
+{
+    static_assert(N != 0 && (N & (N - 1)) == 0, "N must be a power of 2");
+
+  public:
+    BoundedQueue() : m_cells(new Cell[N])
+    {
+        for (std::size_t i = 0; i < N; ++i)
+            m_cells[i].seq.store(i, std::memory_order_relaxed);
+    }
+
+    // Any thread. Return false if full.
+    template <typename V>
+    bool push(V&& value)
+    {
+        auto pos = m_tail.load(std::memory_order_relaxed);
+        for (;;)
+        {
+            Cell& c = m_cells[pos & (N - 1)];
+            auto seq = c.seq.load(std::memory_order_acquire);
+            auto diff = static_cast<std::intptr_t>(seq) -
+                        static_cast<std::intptr_t>(pos);
+            if (diff == 0)
+            {
+                if (m_tail.compare_exchange_weak(pos, pos + 1,
+                                                 std::memory_order_relaxed))
+                {
+                    c.value = std::forward<V>(value);
+                    c.seq.store(pos + 1, std::memory_order_release);
+                    return true;
+                }
+            }
+            else if (diff < 0)
+                return false;
+            else
+                pos = m_tail.load(std::memory_order_relaxed);
+        }
+    }
+
+    // Consumer only. Return false if empty.
+    bool pop(T& value)
+    {
+        auto pos = m_head;
+        Cell& c = m_cells[pos & (N - 1)];
+        if (c.seq.load(std::memory_order_acquire) != pos + 1)
+            return false;
+        value = std::move(c.value);
+        c.seq.store(pos + N, std::memory_order_release);
+        m_head = pos + 1;
+        return true;
+    }
+
+  private:
+    struct Cell
+    {
+        std::atomic<std::size_t> seq;
+        T value;
+    };
+
+    std::unique_ptr<Cell[]> m_cells;
+    alignas(64) std::atomic<std::size_t> m_tail{0};
+    alignas(64) std::size_t m_head = 0;
+};
+} // namespace details
+
+template <typename List, std::size_t PerEvent = 16,
+          std::size_t QueueSize = 256>
+class event_bus;
+
+template <typename... Events, std::size_t PerEvent, std::size_t QueueSize>
+class event_bus<event_list<Events...>, PerEvent, QueueSize>
+{
+  public:
+    template <typename E>
+    using Del = delegate<void(const E&)>;
+
+    // Identify a subscription. Value 0 is never used for a valid one.
+    using handle = std::uint32_t;
+
+    // Dense id of event type E.
+    template <typename E>
+    static constexpr std::size_t event_id() noexcept
+    {
+        constexpr auto id = details::eventIndex<E, Events...>();
+        static_assert(id < sizeof...(Events), "E is not in the event_list");
+        return id;
+    }
+
+    static constexpr std::size_t event_count() noexcept
+    {
+        return sizeof...(Events);
+    }
+
+    /**
+     * Call 'del' on every publish of E. Return 0 if E already has PerEvent
+     * subscribers.
+     */
+    template <typename E>
+    handle subscribe(Del<E> del)
+    {
+        auto& ch = channel<E>();
+        if (ch.size == PerEvent)
+            return 0;
+        if (++m_lastHandle == 0)
+            ++m_lastHandle;
+        ch.dels[ch.size] = del;
+        ch.ids[ch.size] = m_lastHandle;
+        ++ch.size;
+        return m_lastHandle;
+    }
+
+    // Return false if 'h' is not a subscription to E.
+    template <typename E>
+    bool unsubscribe(handle h)
+    {
+        auto& ch = channel<E>();
+        auto ids = ch.ids.data();
+        auto pos = std::find(ids, ids + ch.size, h);
+        if (h == 0 || pos == ids + ch.size)
+            return false;
+
+        // Shift to keep subscription order.
+        auto index = static_cast<std::size_t>(pos - ids);
+        std::move(ch.dels.data() + index + 1, ch.dels.data() + ch.size,
+                  ch.dels.data() + index);
+        std::move(ids + index + 1, ids + ch.size, ids + index);
+        ch.dels[--ch.size].clear();
+        return true;
+    }
+
+    // Call the subscribers of E.
+    template <typename E>
+    void publish(const E& event) const
+    {
+        auto& ch = channel<E>();
+        for (std::size_t i = 0; i < ch.size; ++i)
+            ch.dels[i](event);
+    }
+
+    /**
+     * Queue a copy of 'event' for the next 'drain'. Can be called from any
+     * thread. Return false if the queue is full.
+     */
+    template <typename E>
+    bool post(E&& event)
+    {
+        using T = std::decay_t<E>;
+        event_id<T>(); // Check that T is in the event_list.
+        return m_queue.push(Queued{std::in_place_type<T>,
+                                   std::forward<E>(event)});
+    }
+
+    /**
+     * Publish queued events in posting order, at most 'max'. Return the
+     * number published.
+     */
+    std::size_t drain(std::size_t max = static_cast<std::size_t>(-1))
+    {
+        std::size_t n = 0;
+        Queued q;
+        while (n < max && m_queue.pop(q))
+        {
+            std::visit(
+                [this](const auto& e) {
+                    using T = std::decay_t<decltype(e)>;
+                    if constexpr (!std::is_same<T, std::monostate>::value)
+                        publish(e);
+                },
+                q);
+            ++n;
+        }
+        return n;
+    }
+
+    template <typename E>
+    std::size_t subscriber_count() const noexcept
+    {
+        return channel<E>().size;
+    }
+
+  private:
+    using Queued = std::variant<std::monostate, Events...>;
+
+    template <typename E>
+    auto& channel() noexcept
+    {
+        return std::get<event_id<E>()>(m_channels);
+    }
+
+    template <typename E>
+    const auto& channel() const noexcept
+    {
+        return std::get<event_id<E>()>(m_channels);
+    }
+
+    std::tuple<details::EventChannel<Events, PerEvent>...> m_channels;
+    details::BoundedQueue<Queued, QueueSize> m_queue;
+    handle m_lastHandle = 0;
+};
+
+#endif /* DELEGATE_EVENT_BUS_HPP_ */
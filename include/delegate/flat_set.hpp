@@ -0,0 +1,304 @@
+/*
+ * flat_set.hpp
+ *
+ *  Created on: 18 oct. 2026
+ */
+
+#ifndef DELEGATE_FLAT_SET_HPP_
+#define DELEGATE_FLAT_SET_HPP_
+
+#include "delegate/delegate.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+#include <vector>
+
+/**
+ * Sorted set of delegates stored in one contiguous array.
+ *
+ * Ordered with delegate::Less and unique by delegate::equal, like a
+ * std::set<Del, Del::Less>, but without a node per element. Lookup is a
+ * binary search, iteration walks the array.
+ *
+ *   delegate_flat_set<void(int)> subscribers;
+ *   subscribers.insert(Del::make<&Widget::onChange>(w));
+ *   subscribers.insert_range(dels.begin(), dels.end()); // Sort once.
+ *   for (auto& d : subscribers)
+ *       d(42);
+ *
+ * Single insert and erase shift the elements after the position.
+ * 'insert_range' appends, sorts the new elements and merges them with the
+ * existing ones, prefer it to build large sets. It takes forward iterators.
+ *
+ * The storage is a policy:
+ * - flat_set_vector : std::vector, grows as needed. The default.
+ * - flat_set_static<N> : inline array of N delegates, no heap allocation.
+ *   Inserting in a full set fails. 'insert_range' merges with rotations,
+ *   O(n log n) moves, where the vector storage merges in linear time with
+ *   the temporary buffer of std::inplace_merge.
+ *
+ * Iterators and pointers are invalidated by any modification.
+ */
+
+namespace details
+{
+// Inline storage with the part of the std::vector interface used by
+// delegate_flat_set.
+template <typename T, std::size_t N>
+class StaticVector
+{
+  public:
+    T* data() noexcept
+    {
+        return m_data.data();
+    }
+    const T* data() const noexcept
+    {
+        return m_data.data();
+    }
+
+    std::size_t size() const noexcept
+    {
+        return m_size;
+    }
+
+    constexpr std::size_t max_size() const noexcept
+    {
+        return N;
+    }
+
+    // Requires n <= N.
+    void resize(std::size_t n) noexcept
+    {
+        for (std::size_t i = n; i < m_size; ++i)
+            m_data[i] = T{};
+        m_size = n;
+    }
+
+    void clear() noexcept
+    {
+        resize(0);
+    }
+
+  private:
+    std::array<T, N> m_data{};
+    std::size_t m_size = 0;
+};
+
+// Merge the sorted ranges [first, middle) and [middle, last) in place,
+// without any temporary buffer. Split both around a pivot, rotate the
+// middle parts and recurse.
+template <typename T, typename Less>
+void
+mergeWithoutBuffer(T* first, T* middle, T* last, Less less)
+{
+    if (first == middle || middle == last)
+        return;
+    if (last - first == 2)
+    {
+        if (less(*middle, *first))
+            std::iter_swap(first, middle);
+        return;
+    }
+    T* cut1;
+    T* cut2;
+    if (middle - first > last - middle)
+    {
+        cut1 = first + (middle - first) / 2;
+        cut2 = std::lower_bound(middle, last, *cut1, less);
+    }
+    else
+    {
+        cut2 = middle + (last - middle) / 2;
+        cut1 = std::upper_bound(first, middle, *cut2, less);
+    }
+    T* newMiddle = std::rotate(cut1, middle, cut2);
+    mergeWithoutBuffer(first, cut1, newMiddle, less);
+    mergeWithoutBuffer(newMiddle, cut2, last, less);
+}
+} // namespace details
+
+// Storage policy of delegate_flat_set growing on the heap.
+struct flat_set_vector
+{
+    template <typename T>
+    using type = std::vector<T>;
+
+    static constexpr bool allocates = true;
+};
+
+// Storage policy of delegate_flat_set with a fixed capacity of N.
+template <std::size_t N>
+struct flat_set_static
+{
+    template <typename T>
+    using type = details::StaticVector<T, N>;
+
+    static constexpr bool allocates = false;
+};
+
+template <typename Sig, typename Storage = flat_set_vector>
+class delegate_flat_set;
+
+template <typename R, typename... Args, typename Storage>
+class delegate_flat_set<R(Args...), Storage>
+{
+  public:
+    using Del = delegate<R(Args...)>;
+    using value_type = Del;
+    using const_iterator = const Del*;
+    using iterator = const_iterator;
+
+    /**
+     * Add 'del'. Return false if already present, or if the storage is
+     * full.
+     */
+    bool insert(const Del& del)
+    {
+        auto pos = lowerBound(del);
+        if (pos != end() && pos->equal(del))
+            return false;
+        auto size = m_data.size();
+        if (size == m_data.max_size())
+            return false;
+
+        auto index = static_cast<std::size_t>(pos - begin());
+        m_data.resize(size + 1);
+        auto data = m_data.data();
+        std::move_backward(data + index, data + size, data + size + 1);
+        data[index] = del;
+        return true;
+    }
+
+    /**
+     * Add all delegates in [first, last). Sort the new ones and merge them
+     * into the set in one pass. Return the number of delegates added.
+     * If they do not all fit, they are added one at a time until the
+     * storage is full.
+     */
+    template <typename It>
+    std::size_t insert_range(It first, It last)
+    {
+        static_assert(
+            std::is_base_of<
+                std::forward_iterator_tag,
+                typename std::iterator_traits<It>::iterator_category>::value,
+            "insert_range requires forward iterators, the range is read twice");
+        auto old = m_data.size();
+        auto count = static_cast<std::size_t>(std::distance(first, last));
+        if (count > m_data.max_size() - old)
+        {
+            std::size_t added = 0;
+            for (; first != last; ++first)
+                added += insert(*first) ? 1 : 0;
+            return added;
+        }
+
+        m_data.resize(old + count);
+        auto data = m_data.data();
+        std::copy(first, last, data + old);
+        auto less = typename Del::Less{};
+        auto equal = typename Del::Equal{};
+        std::sort(data + old, data + old + count, less);
+        merge(data, data + old, data + old + count, less,
+              std::integral_constant<bool, Storage::allocates>{});
+        auto newEnd = std::unique(data, data + old + count, equal);
+        auto size = static_cast<std::size_t>(newEnd - data);
+        m_data.resize(size);
+        return size - old;
+    }
+
+    // Remove 'del'. Return false if not present.
+    bool erase(const Del& del)
+    {
+        auto pos = find(del);
+        if (pos == end())
+            return false;
+        auto index = static_cast<std::size_t>(pos - begin());
+        auto data = m_data.data();
+        auto size = m_data.size();
+        std::move(data + index + 1, data + size, data + index);
+        m_data.resize(size - 1);
+        return true;
+    }
+
+    // Return end() if not present.
+    const_iterator find(const Del& del) const noexcept
+    {
+        auto pos = lowerBound(del);
+        return (pos != end() && pos->equal(del)) ? pos : end();
+    }
+
+    bool contains(const Del& del) const noexcept
+    {
+        return find(del) != end();
+    }
+
+    std::size_t count(const Del& del) const noexcept
+    {
+        return contains(del) ? 1 : 0;
+    }
+
+    const_iterator begin() const noexcept
+    {
+        return m_data.data();
+    }
+
+    const_iterator end() const noexcept
+    {
+        return m_data.data() + m_data.size();
+    }
+
+    // Contiguous array of size() delegates in set order.
+    const Del* data() const noexcept
+    {
+        return m_data.data();
+    }
+
+    std::size_t size() const noexcept
+    {
+        return m_data.size();
+    }
+
+    bool empty() const noexcept
+    {
+        return m_data.size() == 0;
+    }
+
+    std::size_t max_size() const noexcept
+    {
+        return m_data.max_size();
+    }
+
+    void clear() noexcept
+    {
+        m_data.clear();
+    }
+
+  private:
+    template <typename Less>
+    static void merge(Del* first, Del* middle, Del* last, Less less,
+                      std::true_type)
+    {
+        std::inplace_merge(first, middle, last, less);
+    }
+
+    template <typename Less>
+    static void merge(Del* first, Del* middle, Del* last, Less less,
+                      std::false_type)
+    {
+        details::mergeWithoutBuffer(first, middle, last, less);
+    }
+
+    const_iterator lowerBound(const Del& del) const noexcept
+    {
+        return std::lower_bound(begin(), end(), del, typename Del::Less{});
+    }
+
+    typename Storage::template type<Del> m_data;
+};
+
+#endif /* DELEGATE_FLAT_SET_HPP_ */
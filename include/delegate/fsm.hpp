@@ -0,0 +1,234 @@
+/*
+ * fsm.hpp
+ *
+ *  Created on: 18 oct. 2026
+ */
+
+#ifndef DELEGATE_FSM_HPP_
+#define DELEGATE_FSM_HPP_
+
+#include "delegate/delegate.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <type_traits>
+
+/**
+ * Finite state machine with the transitions declared at compile time.
+ *
+ *   enum class State { Idle, Connecting, Open };
+ *   enum class Event { Connect, Ack, Close };
+ *
+ *   using ConnFsm = fsm<Conn, void(const Packet&),
+ *       transition<State::Idle, Event::Connect, State::Connecting,
+ *                  &Conn::sendSyn>,
+ *       transition<State::Connecting, Event::Ack, State::Open,
+ *                  &Conn::onAck, &Conn::ackValid>,
+ *       transition<State::Open, Event::Close, State::Idle>>;
+ *
+ *   ConnFsm machine{conn, State::Idle};
+ *   machine.dispatch(Event::Connect, packet);
+ *
+ * A transition is taken when the machine is in 'from' and gets 'event',
+ * and the optional guard, a const member function returning bool, accepts
+ * the arguments. The state becomes 'to', then the optional action, a
+ * member function returning void, is called with the arguments. Actions
+ * may dispatch further events.
+ *
+ * The transitions are compiled into a constexpr dense table indexed by
+ * state and event, holding the delegate trampolines of the actions and
+ * guards. Dispatch is one table lookup and up to two indirect calls, there
+ * is no allocation and no search.
+ *
+ * States and events are enums with values from 0, the table size is the
+ * largest value used plus one. A state and event pair can only have one
+ * transition.
+ */
+
+#if __cplusplus < 201703L
+#error "Require at least C++17 to compile fsm"
+#endif
+
+template <auto from_, auto event_, auto to_, auto action_ = nullptr,
+          auto guard_ = nullptr>
+struct transition
+{
+    static_assert(std::is_enum<decltype(from_)>::value &&
+                      std::is_same<decltype(from_), decltype(to_)>::value,
+                  "States must be values of the same enum");
+    static_assert(std::is_enum<decltype(event_)>::value,
+                  "Events must be enum values");
+
+    static constexpr auto from = from_;
+    static constexpr auto event = event_;
+    static constexpr auto to = to_;
+    static constexpr auto action = action_;
+    static constexpr auto guard = guard_;
+};
+
+namespace details
+{
+// Gives access to the trampoline type of a delegate through
+// DeduceMemberType.
+template <typename R, typename... Args>
+struct FsmProbe
+{
+    R call(Args...);
+};
+
+template <typename Del, typename R, typename... Args>
+using FsmTrampoline = std::remove_const_t<
+    decltype(Del::template DeduceMemberType<
+             decltype(&FsmProbe<R, Args...>::call),
+             &FsmProbe<R, Args...>::call>::trampoline)>;
+
+template <auto v>
+constexpr bool fsmIsSet = !std::is_same<decltype(v), std::nullptr_t>::value;
+
+template <typename E>
+constexpr std::size_t
+fsmIndex(E e) noexcept
+{
+    return static_cast<std::size_t>(e);
+}
+
+template <typename T, typename Sig, typename... Transitions>
+struct FsmTable;
+
+// Dense transition table, 'build' is evaluated at compile time by fsm.
+template <typename T, typename... Args, typename First, typename... Rest>
+struct FsmTable<T, void(Args...), First, Rest...>
+{
+    using State = std::remove_const_t<decltype(First::from)>;
+    using Event = std::remove_const_t<decltype(First::event)>;
+    using Action = delegate<void(Args...)>;
+    using Guard = delegate<bool(Args...)>;
+
+    static constexpr std::size_t stateCount =
+        std::max({fsmIndex(First::from), fsmIndex(First::to),
+                  fsmIndex(Rest::from)..., fsmIndex(Rest::to)...}) +
+        1;
+    static constexpr std::size_t eventCount =
+        std::max({fsmIndex(First::event), fsmIndex(Rest::event)...}) + 1;
+
+    struct Cell
+    {
+        FsmTrampoline<Action, void, Args...> action = nullptr;
+        FsmTrampoline<Guard, bool, Args...> guard = nullptr;
+        State next{};
+        bool valid = false;
+    };
+
+    struct Cells
+    {
+        std::array<Cell, stateCount * eventCount> cells{};
+        bool duplicate = false;
+    };
+
+    template <typename Tr>
+    static constexpr void add(Cells& t)
+    {
+        Cell& cell =
+            t.cells[fsmIndex(Tr::from) * eventCount + fsmIndex(Tr::event)];
+        t.duplicate = t.duplicate || cell.valid;
+        cell.valid = true;
+        cell.next = Tr::to;
+        if constexpr (fsmIsSet<Tr::action>)
+        {
+            using DM = typename Action::template DeduceMemberType<
+                std::remove_const_t<decltype(Tr::action)>, Tr::action>;
+            static_assert(std::is_same<typename DM::ObjType, T>::value,
+                          "Action must be a member function of T");
+            cell.action = DM::trampoline;
+        }
+        if constexpr (fsmIsSet<Tr::guard>)
+        {
+            using DM = typename Guard::template DeduceMemberType<
+                std::remove_const_t<decltype(Tr::guard)>, Tr::guard>;
+            static_assert(std::is_same<typename DM::ObjType, T>::value,
+                          "Guard must be a member function of T");
+            static_assert(DM::cnst, "Guard must be a const member function");
+            cell.guard = DM::trampoline;
+        }
+    }
+
+    static constexpr Cells build() noexcept
+    {
+        Cells t;
+        add<First>(t);
+        (add<Rest>(t), ...);
+        return t;
+    }
+};
+} // namespace details
+
+template <typename T, typename Sig, typename... Transitions>
+class fsm
+{
+    using Table = details::FsmTable<T, Sig, Transitions...>;
+    using Cell = typename Table::Cell;
+
+    static constexpr auto s_built = Table::build();
+    static_assert(!s_built.duplicate,
+                  "Only one transition per state and event is allowed");
+
+  public:
+    using State = typename Table::State;
+    using Event = typename Table::Event;
+    using Action = typename Table::Action;
+    using Guard = typename Table::Guard;
+
+    static constexpr std::size_t state_count = Table::stateCount;
+    static constexpr std::size_t event_count = Table::eventCount;
+
+    fsm(T& obj, State initial) noexcept : m_obj(&obj), m_state(initial) {}
+
+    /**
+     * Take the transition for 'event' from the current state, if any and
+     * if its guard accepts 'args'. Return false if no transition was taken.
+     */
+    template <typename... A>
+    bool dispatch(Event event, A&&... args)
+    {
+        auto s = details::fsmIndex(m_state);
+        auto e = details::fsmIndex(event);
+        if (s >= state_count || e >= event_count)
+            return false;
+        const Cell& cell = s_built.cells[s * event_count + e];
+        if (!cell.valid)
+            return false;
+        if (cell.guard && !Guard::makeVoidCB(cell.guard, m_obj)(args...))
+            return false;
+        m_state = cell.next;
+        if (cell.action)
+            Action::makeVoidCB(cell.action, m_obj)(args...);
+        return true;
+    }
+
+    State state() const noexcept
+    {
+        return m_state;
+    }
+
+    // Force the state, no action is called.
+    void reset(State state) noexcept
+    {
+        m_state = state;
+    }
+
+    // True if a transition exists, whatever its guard.
+    static constexpr bool can_handle(State state, Event event) noexcept
+    {
+        auto s = details::fsmIndex(state);
+        auto e = details::fsmIndex(event);
+        return s < state_count && e < event_count &&
+               s_built.cells[s * event_count + e].valid;
+    }
+
+  private:
+    void* m_obj;
+    State m_state;
+};
+
+#endif /* DELEGATE_FSM_HPP_ */
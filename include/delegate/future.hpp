@@ -0,0 +1,210 @@
+/*
+ * future.hpp
+ *
+ *  Created on: 18 oct. 2026
+ */
+
+#ifndef DELEGATE_FUTURE_HPP_
+#define DELEGATE_FUTURE_HPP_
+
+#include "delegate/delegate.hpp"
+
+#include <atomic>
+#include <optional>
+#include <utility>
+
+/**
+ * Promise and future without heap allocation, completed through one
+ * delegate continuation.
+ *
+ *   future_state<Reply> state;               // Storage from the caller.
+ *   promise<Reply> p{state};
+ *   client.request(query, p);                // Will call p.set_value(...).
+ *
+ *   then_stage<Reply, int> parse{delegate<int(Reply&&)>::make<&parseReply>()};
+ *   p.get_future().then(parse).then(
+ *       delegate<void(int&&)>::make<&Ui::show>(ui));
+ *
+ * The shared state lives in a future_state provided by the caller, it must
+ * outlive the promise, the future and the continuation call. A state holds
+ * the value and one delegate<void(T&&)> continuation. Completion is
+ * lock-free: 'set_value' and 'then' each publish their part with one
+ * atomic or, and whichever comes second calls the continuation, with the
+ * value moved out of the state. So the continuation runs on the thread
+ * calling 'set_value', or on the thread calling 'then' if the value was
+ * already there.
+ *
+ * 'then' with a then_stage<T, U> chains a transformation: the stage holds
+ * the delegate<U(T&&)> and the future_state<U> of the next step inline, and
+ * gives back its future.
+ *
+ * Nothing blocks: 'get' requires 'ready'. 'set_value' and 'then' are called
+ * at most once per state, until 'reset'. A promise destroyed without a
+ * value leaves its future never ready.
+ */
+
+#if __cplusplus < 201703L
+#error "Require at least C++17 to compile future"
+#endif
+
+template <typename T>
+class promise;
+
+template <typename T>
+class future;
+
+template <typename T>
+class future_state
+{
+  public:
+    using Continuation = delegate<void(T&&)>;
+
+    future_state() = default;
+    future_state(const future_state&) = delete;
+    future_state& operator=(const future_state&) = delete;
+
+    bool ready() const noexcept
+    {
+        return m_flags.load(std::memory_order_acquire) & valueSet;
+    }
+
+    /**
+     * Make the state usable for a new promise. Not safe concurrently with
+     * any other use.
+     */
+    void reset() noexcept
+    {
+        m_value.reset();
+        m_then.clear();
+        m_flags.store(0, std::memory_order_relaxed);
+    }
+
+  private:
+    friend class promise<T>;
+    friend class future<T>;
+    template <typename, typename>
+    friend class then_stage;
+
+    static constexpr unsigned char valueSet = 1;
+    static constexpr unsigned char thenSet = 2;
+
+    template <typename... A>
+    void complete(A&&... args)
+    {
+        m_value.emplace(std::forward<A>(args)...);
+        auto prev = m_flags.fetch_or(valueSet, std::memory_order_acq_rel);
+        if (prev & thenSet)
+            m_then(std::move(*m_value));
+    }
+
+    void setThen(Continuation then)
+    {
+        m_then = then;
+        auto prev = m_flags.fetch_or(thenSet, std::memory_order_acq_rel);
+        if (prev & valueSet)
+            m_then(std::move(*m_value));
+    }
+
+    std::optional<T> m_value;
+    Continuation m_then;
+    std::atomic<unsigned char> m_flags{0};
+};
+
+template <typename T, typename U>
+class then_stage
+{
+  public:
+    using Transform = delegate<U(T&&)>;
+
+    explicit then_stage(Transform transform) noexcept
+        : m_transform(transform)
+    {
+    }
+
+    then_stage(const then_stage&) = delete;
+    then_stage& operator=(const then_stage&) = delete;
+
+    // Make the stage usable for a new chain.
+    void reset() noexcept
+    {
+        m_state.reset();
+    }
+
+  private:
+    friend class future<T>;
+
+    void run(T&& value)
+    {
+        m_state.complete(m_transform(std::move(value)));
+    }
+
+    Transform m_transform;
+    future_state<U> m_state;
+};
+
+template <typename T>
+class future
+{
+  public:
+    using Continuation = delegate<void(T&&)>;
+
+    explicit future(future_state<T>& state) noexcept : m_state(&state) {}
+
+    bool ready() const noexcept
+    {
+        return m_state->ready();
+    }
+
+    // Requires ready(), and no continuation, which takes the value.
+    T& get() noexcept
+    {
+        return *m_state->m_value;
+    }
+
+    /**
+     * Call 'then' with the value, now if ready, else from 'set_value'.
+     */
+    void then(Continuation then)
+    {
+        m_state->setThen(then);
+    }
+
+    /**
+     * Pass the value through the transformation of 'stage', and return the
+     * future of its result.
+     */
+    template <typename U>
+    future<U> then(then_stage<T, U>& stage)
+    {
+        using Stage = then_stage<T, U>;
+        m_state->setThen(Continuation::template make<&Stage::run>(stage));
+        return future<U>{stage.m_state};
+    }
+
+  private:
+    future_state<T>* m_state;
+};
+
+template <typename T>
+class promise
+{
+  public:
+    explicit promise(future_state<T>& state) noexcept : m_state(&state) {}
+
+    future<T> get_future() const noexcept
+    {
+        return future<T>{*m_state};
+    }
+
+    // Construct the value from 'args' and run the continuation if set.
+    template <typename... A>
+    void set_value(A&&... args)
+    {
+        m_state->complete(std::forward<A>(args)...);
+    }
+
+  private:
+    future_state<T>* m_state;
+};
+
+#endif /* DELEGATE_FUTURE_HPP_ */
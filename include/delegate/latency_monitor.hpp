@@ -0,0 +1,305 @@
+/*
+ * latency_monitor.hpp
+ *
+ *  Created on: 18 oct. 2026
+ */
+
+#ifndef DELEGATE_LATENCY_MONITOR_HPP_
+#define DELEGATE_LATENCY_MONITOR_HPP_
+
+#include "delegate/delegate.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <type_traits>
+
+/**
+ * Per callback latency histograms and deadline checks.
+ *
+ *   void onOverrun(const Del& d, std::chrono::nanoseconds t);
+ *
+ *   latency_monitor<void(double)> monitor{
+ *       latency_monitor<void(double)>::Overrun::make<&onOverrun>()};
+ *   auto step = Del::make<&Physics::step>(physics);
+ *   monitor.track(step, std::chrono::microseconds(500));
+ *
+ *   monitor.call(step, dt); // In the loop, instead of step(dt).
+ *
+ *   auto s = monitor.stats(step); // From any thread: p50, p99, max.
+ *
+ * Each tracked delegate gets a fixed size log-linear histogram: 16 linear
+ * sub-buckets per power of two, so recorded values are within 1/16 of the
+ * real latency. 'call' measures the call with steady_clock by default,
+ * finds the histogram with a hash of the delegate and increments one bucket
+ * with a relaxed atomic add. When the delegate has a deadline and the call
+ * took longer, the overrun delegate is called on the same thread.
+ *
+ * Reading statistics is lock-free and can run concurrently with calls, the
+ * result is then a close approximation. Delegates are tracked by identity,
+ * as 'delegate::equal': the same member function on two objects is two
+ * callbacks. Calls of delegates not tracked are only counted.
+ */
+
+#if __cplusplus < 201703L
+#error "Require at least C++17 to compile latency_monitor"
+#endif
+
+/**
+ * Log-linear histogram of durations in nanoseconds, up to about 18
+ * minutes. Recording and reading are lock-free.
+ */
+class latency_histogram
+{
+  public:
+    static constexpr unsigned subBits = 4;
+    static constexpr unsigned maxExponent = 40;
+    static constexpr std::size_t bucketCount =
+        (maxExponent - subBits + 2) << subBits;
+
+    void record(std::uint64_t ns) noexcept
+    {
+        m_buckets[index(ns)].fetch_add(1, std::memory_order_relaxed);
+        auto max = m_max.load(std::memory_order_relaxed);
+        while (ns > max && !m_max.compare_exchange_weak(
+                               max, ns, std::memory_order_relaxed))
+        {
+        }
+    }
+
+    std::uint64_t count() const noexcept
+    {
+        std::uint64_t n = 0;
+        for (auto& b : m_buckets)
+            n += b.load(std::memory_order_relaxed);
+        return n;
+    }
+
+    /**
+     * Smallest value, rounded up to its bucket, with at least 'p' (0 to 1)
+     * of the recorded values at or below it. 0 if empty.
+     */
+    std::uint64_t percentile(double p) const noexcept
+    {
+        auto total = count();
+        if (total == 0)
+            return 0;
+        auto target = static_cast<std::uint64_t>(std::ceil(p * total));
+        if (target == 0)
+            target = 1;
+        std::uint64_t seen = 0;
+        for (std::size_t i = 0; i < bucketCount; ++i)
+        {
+            seen += m_buckets[i].load(std::memory_order_relaxed);
+            if (seen >= target)
+                return std::min(upperBound(i), max());
+        }
+        return max();
+    }
+
+    std::uint64_t max() const noexcept
+    {
+        return m_max.load(std::memory_order_relaxed);
+    }
+
+    // Not safe concurrently with 'record'.
+    void reset() noexcept
+    {
+        for (auto& b : m_buckets)
+            b.store(0, std::memory_order_relaxed);
+        m_max.store(0, std::memory_order_relaxed);
+    }
+
+    static constexpr std::size_t index(std::uint64_t ns) noexcept
+    {
+        constexpr std::uint64_t sub = std::uint64_t{1} << subBits;
+        if (ns < sub)
+            return static_cast<std::size_t>(ns);
+        unsigned exponent = 63 - static_cast<unsigned>(__builtin_clzll(ns));
+        if (exponent > maxExponent)
+            return bucketCount - 1;
+        auto mantissa = (ns >> (exponent - subBits)) & (sub - 1);
+        return static_cast<std::size_t>(
+            ((exponent - subBits + 1) << subBits) + mantissa);
+    }
+
+    // Largest value recorded in bucket 'i'.
+    static constexpr std::uint64_t upperBound(std::size_t i) noexcept
+    {
+        constexpr std::uint64_t sub = std::uint64_t{1} << subBits;
+        if (i < sub)
+            return i;
+        auto exponent = (i >> subBits) + subBits - 1;
+        auto mantissa = i & (sub - 1);
+        auto step = std::uint64_t{1} << (exponent - subBits);
+        return ((sub + mantissa) << (exponent - subBits)) + step - 1;
+    }
+
+  private:
+    std::atomic<std::uint64_t> m_buckets[bucketCount] = {};
+    std::atomic<std::uint64_t> m_max{0};
+};
+
+struct latency_stats
+{
+    std::uint64_t count = 0;
+    std::uint64_t p50 = 0; // Nanoseconds.
+    std::uint64_t p99 = 0;
+    std::uint64_t max = 0;
+    std::uint64_t overruns = 0;
+};
+
+/**
+ * 'Clock' is a std::chrono clock, the two reads around each call are most
+ * of the overhead. A clock reading the CPU time stamp counter can be given
+ * where steady_clock is slow.
+ */
+template <typename Sig, std::size_t Slots = 64,
+          typename Clock = std::chrono::steady_clock>
+class latency_monitor;
+
+template <typename R, typename... Args, std::size_t Slots, typename Clock>
+class latency_monitor<R(Args...), Slots, Clock>
+{
+  public:
+    using Del = delegate<R(Args...)>;
+    using Overrun = delegate<void(const Del&, std::chrono::nanoseconds)>;
+
+    static_assert(Slots != 0 && (Slots & (Slots - 1)) == 0,
+                  "Slots must be a power of 2");
+
+    explicit latency_monitor(Overrun onOverrun = Overrun{})
+        : m_onOverrun(onOverrun), m_entries(new Entry[Slots])
+    {
+    }
+
+    latency_monitor(const latency_monitor&) = delete;
+    latency_monitor& operator=(const latency_monitor&) = delete;
+
+    /**
+     * Start recording calls of 'del', and check them against 'deadline'
+     * if not zero. Calling again updates the deadline. Return false if
+     * all slots are used.
+     */
+    bool track(const Del& del,
+               std::chrono::nanoseconds deadline = std::chrono::nanoseconds{0})
+    {
+        std::lock_guard<std::mutex> lock(m_trackLock);
+        auto start = Del::hash(del);
+        for (std::size_t i = 0; i < Slots; ++i)
+        {
+            Entry& e = m_entries[(start + i) & (Slots - 1)];
+            bool ready = e.ready.load(std::memory_order_relaxed);
+            if (ready && !e.del.equal(del))
+                continue;
+            e.deadline.store(deadline.count(), std::memory_order_relaxed);
+            if (!ready)
+            {
+                e.del = del;
+                e.ready.store(true, std::memory_order_release);
+            }
+            return true;
+        }
+        return false;
+    }
+
+    // Call 'del', record its latency and check its deadline.
+    R call(const Del& del, Args... args)
+    {
+        Entry* e = find(del);
+        auto start = Clock::now();
+        if constexpr (std::is_void<R>::value)
+        {
+            del(args...);
+            finish(e, del, start);
+        }
+        else
+        {
+            R res = del(args...);
+            finish(e, del, start);
+            return res;
+        }
+    }
+
+    // Nullptr if 'del' is not tracked.
+    const latency_histogram* histogram(const Del& del) const noexcept
+    {
+        const Entry* e = find(del);
+        return e ? &e->hist : nullptr;
+    }
+
+    // All zero if 'del' is not tracked.
+    latency_stats stats(const Del& del) const noexcept
+    {
+        latency_stats s;
+        if (const Entry* e = find(del))
+        {
+            s.count = e->hist.count();
+            s.p50 = e->hist.percentile(0.5);
+            s.p99 = e->hist.percentile(0.99);
+            s.max = e->hist.max();
+            s.overruns = e->overruns.load(std::memory_order_relaxed);
+        }
+        return s;
+    }
+
+    // Calls of delegates that were not tracked.
+    std::uint64_t untracked() const noexcept
+    {
+        return m_untracked.load(std::memory_order_relaxed);
+    }
+
+  private:
+    struct alignas(64) Entry
+    {
+        std::atomic<bool> ready{false};
+        Del del;
+        std::atomic<std::int64_t> deadline{0};
+        std::atomic<std::uint64_t> overruns{0};
+        latency_histogram hist;
+    };
+
+    Entry* find(const Del& del) const noexcept
+    {
+        auto start = Del::hash(del);
+        for (std::size_t i = 0; i < Slots; ++i)
+        {
+            Entry& e = m_entries[(start + i) & (Slots - 1)];
+            if (!e.ready.load(std::memory_order_acquire))
+                return nullptr;
+            if (e.del.equal(del))
+                return &e;
+        }
+        return nullptr;
+    }
+
+    void finish(Entry* e, const Del& del, typename Clock::time_point start)
+    {
+        auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            Clock::now() - start);
+        if (!e)
+        {
+            m_untracked.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        e->hist.record(static_cast<std::uint64_t>(elapsed.count()));
+        auto deadline = e->deadline.load(std::memory_order_relaxed);
+        if (deadline != 0 && elapsed.count() > deadline)
+        {
+            e->overruns.fetch_add(1, std::memory_order_relaxed);
+            m_onOverrun(del, elapsed);
+        }
+    }
+
+    Overrun m_onOverrun;
+    std::unique_ptr<Entry[]> m_entries;
+    std::mutex m_trackLock;
+    std::atomic<std::uint64_t> m_untracked{0};
+};
+
+#endif /* DELEGATE_LATENCY_MONITOR_HPP_ */
@@ -0,0 +1,221 @@
+/*
+ * lazy.hpp
+ *
+ *  Created on: 18 oct. 2026
+ */
+
+#ifndef DELEGATE_LAZY_HPP_
+#define DELEGATE_LAZY_HPP_
+
+#include "delegate/delegate.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <new>
+#include <thread>
+
+/**
+ * Value computed on first access by calling a delegate<T()> initializer.
+ *
+ * - lazy<T> : Thread safe. The initializer is called exactly once, other
+ *   threads wait for it to finish. Once initialized a read is a single
+ *   acquire load and a branch.
+ * - resettable_lazy<T> : As lazy but 'reset' drop the value so the next
+ *   access compute it again. Use for invalidation.
+ * - local_lazy<T> : No synchronization. Intended for thread_local objects or
+ *   single threaded use.
+ *
+ * The value is stored inline, there is no heap allocation.
+ *
+ *   lazy<Table> table{delegate<Table()>::make<buildTable>()};
+ *   table->lookup(x); // First access call buildTable.
+ */
+
+#if __cplusplus < 201703L
+#error "Require at least C++17 to compile lazy"
+#endif
+
+template <typename T>
+class lazy
+{
+  public:
+    using Init = delegate<T()>;
+
+    explicit constexpr lazy(Init init) noexcept : m_init(init) {}
+
+    lazy(const lazy&) = delete;
+    lazy& operator=(const lazy&) = delete;
+
+    ~lazy()
+    {
+        if (m_state.load(std::memory_order_acquire) == ready)
+            ptr()->~T();
+    }
+
+    // Return the value, computing it on first access.
+    T& get()
+    {
+        if (m_state.load(std::memory_order_acquire) == ready)
+            return *ptr();
+        return initialize();
+    }
+
+    T& operator*()
+    {
+        return get();
+    }
+
+    T* operator->()
+    {
+        return &get();
+    }
+
+    bool initialized() const noexcept
+    {
+        return m_state.load(std::memory_order_acquire) == ready;
+    }
+
+  protected:
+    enum : std::uint8_t
+    {
+        empty,
+        busy,
+        ready
+    };
+
+    T* ptr() noexcept
+    {
+        return std::launder(reinterpret_cast<T*>(m_storage));
+    }
+
+    // Go back to 'empty' if the initializer leave by an exception.
+    struct BusyGuard
+    {
+        ~BusyGuard()
+        {
+            if (!done)
+                state.store(empty, std::memory_order_release);
+        }
+        std::atomic<std::uint8_t>& state;
+        bool done = false;
+    };
+
+    __attribute__((noinline)) T& initialize()
+    {
+        for (;;)
+        {
+            std::uint8_t s = empty;
+            if (m_state.compare_exchange_strong(s, busy,
+                                                std::memory_order_acquire))
+            {
+                BusyGuard guard{m_state};
+                ::new (static_cast<void*>(m_storage)) T(m_init());
+                guard.done = true;
+                m_state.store(ready, std::memory_order_release);
+                return *ptr();
+            }
+            if (s == ready)
+                return *ptr();
+            std::this_thread::yield();
+        }
+    }
+
+    alignas(T) unsigned char m_storage[sizeof(T)];
+    Init m_init;
+    std::atomic<std::uint8_t> m_state{empty};
+};
+
+template <typename T>
+class resettable_lazy : public lazy<T>
+{
+    using Base = lazy<T>;
+
+  public:
+    using Base::Base;
+
+    /**
+     * Drop the value. The next access call the initializer again.
+     * Must not run concurrently with threads still using a reference to the
+     * old value.
+     */
+    void reset()
+    {
+        for (;;)
+        {
+            std::uint8_t s = Base::ready;
+            if (this->m_state.compare_exchange_strong(
+                    s, Base::busy, std::memory_order_acquire))
+            {
+                this->ptr()->~T();
+                this->m_state.store(Base::empty, std::memory_order_release);
+                return;
+            }
+            if (s == Base::empty)
+                return;
+            std::this_thread::yield();
+        }
+    }
+};
+
+template <typename T>
+class local_lazy
+{
+  public:
+    using Init = delegate<T()>;
+
+    explicit constexpr local_lazy(Init init) noexcept : m_init(init) {}
+
+    local_lazy(const local_lazy&) = delete;
+    local_lazy& operator=(const local_lazy&) = delete;
+
+    ~local_lazy()
+    {
+        reset();
+    }
+
+    T& get()
+    {
+        if (!m_ready)
+        {
+            ::new (static_cast<void*>(m_storage)) T(m_init());
+            m_ready = true;
+        }
+        return *ptr();
+    }
+
+    T& operator*()
+    {
+        return get();
+    }
+
+    T* operator->()
+    {
+        return &get();
+    }
+
+    bool initialized() const noexcept
+    {
+        return m_ready;
+    }
+
+    void reset()
+    {
+        if (m_ready)
+        {
+            m_ready = false;
+            ptr()->~T();
+        }
+    }
+
+  private:
+    T* ptr() noexcept
+    {
+        return std::launder(reinterpret_cast<T*>(m_storage));
+    }
+
+    alignas(T) unsigned char m_storage[sizeof(T)];
+    Init m_init;
+    bool m_ready = false;
+};
+
+#endif /* DELEGATE_LAZY_HPP_ */
@@ -0,0 +1,166 @@
+/*
+ * memoized.hpp
+ *
+ *  Created on: 18 oct. 2026
+ */
+
+#ifndef DELEGATE_MEMOIZED_HPP_
+#define DELEGATE_MEMOIZED_HPP_
+
+#include "delegate/delegate.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <tuple>
+#include <type_traits>
+
+/**
+ * Result cache in front of a delegate to a pure function.
+ *
+ * memoized<Sig, N, Ways> keep at most N results in a set associative cache
+ * with 'Ways' entries per set. Entries are selected on a hash of the
+ * arguments and replaced least recently used within a set.
+ * All storage is inline, there is no heap allocation.
+ *
+ * The memoized object is a functor. Use 'get_delegate' to hand out an
+ * ordinary delegate to it. As for other functors the memoized object must
+ * outlive the delegate.
+ *
+ *   memoized<int(int, int), 256> cache{Del::make<&Routes::lookup>(routes)};
+ *   delegate<int(int, int)> del = cache.get_delegate();
+ *   del(1, 2); // Miss, call Routes::lookup.
+ *   del(1, 2); // Hit.
+ *
+ * Arguments must be hashable with std::hash and equality comparable. Argument
+ * and result types must be default constructible and copy assignable.
+ * The cache is not thread safe.
+ */
+
+#if __cplusplus < 201703L
+#error "Require at least C++17 to compile memoized"
+#endif
+
+template <typename Sig, std::size_t N, std::size_t Ways = 4>
+class memoized;
+
+template <typename R, typename... Args, std::size_t N, std::size_t Ways>
+class memoized<R(Args...), N, Ways>
+{
+    static_assert(!std::is_void<R>::value, "Can not memoize a void function");
+    static_assert(Ways > 0 && N >= Ways && N % Ways == 0,
+                  "N must be a multiple of Ways");
+
+  public:
+    using Del = delegate<R(Args...)>;
+
+    explicit memoized(Del fn = Del{}) noexcept : m_fn(fn) {}
+
+    // The functor refer to itself. Do not copy.
+    memoized(const memoized&) = delete;
+    memoized& operator=(const memoized&) = delete;
+
+    R operator()(Args... args)
+    {
+        auto h = hash(args...);
+        auto* set = &m_entries[(h % sets) * Ways];
+        ++m_tick;
+
+        Entry* victim = set;
+        for (std::size_t i = 0; i < Ways; ++i)
+        {
+            Entry& e = set[i];
+            if (e.stamp != 0 && e.hash == h && e.key == std::tie(args...))
+            {
+                ++m_hits;
+                e.stamp = m_tick;
+                return e.value;
+            }
+            if (e.stamp < victim->stamp)
+                victim = &e;
+        }
+
+        ++m_misses;
+        victim->value = m_fn(args...);
+        victim->key = Key{args...};
+        victim->hash = h;
+        victim->stamp = m_tick;
+        return victim->value;
+    }
+
+    // Delegate calling this cache.
+    Del get_delegate() noexcept
+    {
+        return Del::make(*this);
+    }
+
+    // Set a new function. Cached results are dropped.
+    void set(Del fn) noexcept
+    {
+        m_fn = fn;
+        clear();
+    }
+
+    // Drop all cached results. Use when the underlying data changes.
+    void clear() noexcept
+    {
+        for (auto& e : m_entries)
+            e.stamp = 0;
+    }
+
+    std::uint64_t hits() const noexcept
+    {
+        return m_hits;
+    }
+
+    std::uint64_t misses() const noexcept
+    {
+        return m_misses;
+    }
+
+    void reset_stats() noexcept
+    {
+        m_hits = 0;
+        m_misses = 0;
+    }
+
+    static constexpr std::size_t capacity() noexcept
+    {
+        return N;
+    }
+
+  private:
+    static constexpr std::size_t sets = N / Ways;
+
+    using Key = std::tuple<std::decay_t<Args>...>;
+
+    struct Entry
+    {
+        std::uint64_t stamp = 0; // Last use, 0 when empty.
+        std::size_t hash = 0;
+        Key key{};
+        R value{};
+    };
+
+    static std::size_t hash(const std::decay_t<Args>&... args) noexcept
+    {
+        std::size_t h = 0;
+        ((h ^= std::hash<std::decay_t<Args>>{}(args) + 0x9e3779b97f4a7c15u +
+               (h << 6) + (h >> 2)),
+         ...);
+        // Spread low quality hashes (e.g. identity for integers) over the sets.
+        h ^= h >> 33;
+        h *= 0xff51afd7ed558ccdu;
+        h ^= h >> 33;
+        return h;
+    }
+
+    Del m_fn;
+    std::uint64_t m_tick = 0;
+    std::uint64_t m_hits = 0;
+    std::uint64_t m_misses = 0;
+    std::array<Entry, N> m_entries{};
+};
+
+#endif /* DELEGATE_MEMOIZED_HPP_ */
@@ -0,0 +1,129 @@
+/*
+ * parallel_emit.hpp
+ *
+ *  Created on: 18 oct. 2026
+ */
+
+#ifndef DELEGATE_PARALLEL_EMIT_HPP_
+#define DELEGATE_PARALLEL_EMIT_HPP_
+
+#include "delegate/delegate.hpp"
+#include "delegate/thread_pool.hpp"
+
+#include <array>
+#include <cstddef>
+#include <tuple>
+
+/**
+ * Call a list of delegates, sequentially or spread over a thread_pool.
+ *
+ *   std::vector<delegate<void(const Frame&)>> shards = ...;
+ *   emit_parallel(pool, shards.data(), shards.size(), frame);
+ *   emit_sequential(shards.data(), shards.size(), frame);
+ *
+ * The subscribers are split in contiguous chunks, one per worker plus one
+ * run by the calling thread. The caller then wait on a latch on its own
+ * stack, helping with queued tasks meanwhile. Arguments are passed to all
+ * subscribers by const reference, there are no copies and no heap
+ * allocation.
+ *
+ * Below 'parallel_policy::threshold' subscribers the list is called
+ * sequentially on the calling thread, since the hand off cost more than it
+ * gain for light subscribers.
+ *
+ * Subscribers must be safe to call concurrently with each other. Return
+ * values are discarded.
+ */
+
+#if __cplusplus < 201703L
+#error "Require at least C++17 to compile parallel_emit"
+#endif
+
+struct parallel_policy
+{
+    // Emit sequentially if there are fewer subscribers than this.
+    std::size_t threshold = 16;
+};
+
+namespace details
+{
+// Upper limit of chunks per emit. Bound the stack usage.
+constexpr std::size_t maxEmitChunks = 64;
+
+template <typename Del, typename... CallArgs>
+struct EmitChunk
+{
+    using ArgRefs = std::tuple<const CallArgs&...>;
+
+    void operator()() const
+    {
+        for (auto it = first; it != last; ++it)
+            std::apply(*it, *args);
+        done->count_down();
+    }
+
+    const Del* first = nullptr;
+    const Del* last = nullptr;
+    const ArgRefs* args = nullptr;
+    delegate_latch* done = nullptr;
+};
+} // namespace details
+
+// Call all delegates in order on the calling thread.
+template <typename R, typename... Args, typename... CallArgs>
+void
+emit_sequential(const delegate<R(Args...)>* dels, std::size_t count,
+                const CallArgs&... args)
+{
+    for (std::size_t i = 0; i < count; ++i)
+        dels[i](args...);
+}
+
+template <typename R, typename... Args, typename... CallArgs>
+void
+emit_parallel(thread_pool& pool, parallel_policy policy,
+              const delegate<R(Args...)>* dels, std::size_t count,
+              const CallArgs&... args)
+{
+    using Del = delegate<R(Args...)>;
+    using Chunk = details::EmitChunk<Del, CallArgs...>;
+
+    std::size_t chunks = pool.size() + 1;
+    if (chunks > details::maxEmitChunks)
+        chunks = details::maxEmitChunks;
+    if (chunks > count)
+        chunks = count;
+    if (count < policy.threshold || chunks < 2)
+    {
+        emit_sequential(dels, count, args...);
+        return;
+    }
+
+    typename Chunk::ArgRefs argRefs{args...};
+    delegate_latch done{static_cast<std::ptrdiff_t>(chunks)};
+    std::array<Chunk, details::maxEmitChunks> work;
+    for (std::size_t i = 0; i < chunks; ++i)
+    {
+        work[i].first = dels + count * i / chunks;
+        work[i].last = dels + count * (i + 1) / chunks;
+        work[i].args = &argRefs;
+        work[i].done = &done;
+    }
+
+    // Hand out all but the last chunk. Run them here if the queue is full.
+    for (std::size_t i = 0; i + 1 < chunks; ++i)
+        if (!pool.try_submit(delegate<void()>::make(work[i])))
+            work[i]();
+    work[chunks - 1]();
+    pool.wait(done);
+}
+
+template <typename R, typename... Args, typename... CallArgs>
+void
+emit_parallel(thread_pool& pool, const delegate<R(Args...)>* dels,
+              std::size_t count, const CallArgs&... args)
+{
+    emit_parallel(pool, parallel_policy{}, dels, count, args...);
+}
+
+#endif /* DELEGATE_PARALLEL_EMIT_HPP_ */
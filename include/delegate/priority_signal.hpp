@@ -0,0 +1,168 @@
+/*
+ * priority_signal.hpp
+ *
+ *  Created on: 18 oct. 2026
+ */
+
+#ifndef DELEGATE_PRIORITY_SIGNAL_HPP_
+#define DELEGATE_PRIORITY_SIGNAL_HPP_
+
+#include "delegate/delegate.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * Signal calling its subscribers in priority order with early exit.
+ *
+ * priority_signal<bool(Args...), N> store up to N delegate<bool(Args...)>.
+ * Emit call them with the highest priority first, subscribers with equal
+ * priority in the order they were connected. A subscriber return true to
+ * consume the event, which stops the propagation.
+ *
+ *   priority_signal<bool(const Key&), 16> onKey;
+ *   auto h = onKey.connect(Del::make<&Dialog::onKey>(dlg), 10);
+ *   onKey.connect(Del::make<&Editor::onKey>(ed), 0);
+ *   bool consumed = onKey.emit(key);
+ *   onKey.disconnect(h);
+ *
+ * Delegates are kept sorted in a contiguous array, separate from the sort
+ * keys, so emit only touches the delegates. Connect and disconnect shift
+ * elements in place, there is no heap allocation.
+ * The signal must not be modified from within emit.
+ */
+
+template <typename Sig, std::size_t N>
+class priority_signal;
+
+template <typename... Args, std::size_t N>
+class priority_signal<bool(Args...), N>
+{
+  public:
+    using Del = delegate<bool(Args...)>;
+
+    // Identify a connection. Value 0 is never used for a valid connection.
+    using handle = std::uint32_t;
+
+    /**
+     * Add a subscriber. Higher priorities are called first.
+     * Return 0 if the signal is full.
+     */
+    handle connect(Del del, int priority = 0) noexcept
+    {
+        if (m_size == N)
+            return 0;
+
+        // Place after all entries with priority >= 'priority'.
+        std::size_t pos = m_size;
+        while (pos > 0 && m_keys[pos - 1].priority < priority)
+            --pos;
+
+        auto dels = m_dels.data();
+        auto keys = m_keys.data();
+        std::move_backward(dels + pos, dels + m_size, dels + m_size + 1);
+        std::move_backward(keys + pos, keys + m_size, keys + m_size + 1);
+        m_dels[pos] = del;
+        m_keys[pos] = Key{priority, nextHandle()};
+        ++m_size;
+        return m_keys[pos].id;
+    }
+
+    // Remove a subscriber. Return false if not connected.
+    bool disconnect(handle h) noexcept
+    {
+        for (std::size_t i = 0; i < m_size; ++i)
+        {
+            if (m_keys[i].id == h)
+            {
+                erase(i);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Remove the first subscriber equal to 'del'.
+    bool disconnect(const Del& del) noexcept
+    {
+        for (std::size_t i = 0; i < m_size; ++i)
+        {
+            if (m_dels[i] == del)
+            {
+                erase(i);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /**
+     * Call subscribers in priority order until one return true.
+     * Return true if the event was consumed.
+     */
+    bool emit(Args... args) const
+    {
+        for (std::size_t i = 0; i < m_size; ++i)
+            if (m_dels[i](args...))
+                return true;
+        return false;
+    }
+
+    bool operator()(Args... args) const
+    {
+        return emit(args...);
+    }
+
+    void clear() noexcept
+    {
+        m_size = 0;
+    }
+
+    std::size_t size() const noexcept
+    {
+        return m_size;
+    }
+
+    bool empty() const noexcept
+    {
+        return m_size == 0;
+    }
+
+    static constexpr std::size_t capacity() noexcept
+    {
+        return N;
+    }
+
+  private:
+    struct Key
+    {
+        int priority;
+        handle id;
+    };
+
+    handle nextHandle() noexcept
+    {
+        if (++m_lastHandle == 0)
+            ++m_lastHandle;
+        return m_lastHandle;
+    }
+
+    void erase(std::size_t i) noexcept
+    {
+        auto dels = m_dels.data();
+        auto keys = m_keys.data();
+        std::move(dels + i + 1, dels + m_size, dels + i);
+        std::move(keys + i + 1, keys + m_size, keys + i);
+        --m_size;
+        m_dels[m_size].clear();
+    }
+
+    std::array<Del, N> m_dels{};
+    std::size_t m_size = 0;
+    handle m_lastHandle = 0;
+    std::array<Key, N> m_keys{};
+};
+
+#endif /* DELEGATE_PRIORITY_SIGNAL_HPP_ */
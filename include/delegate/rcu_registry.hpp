@@ -0,0 +1,325 @@
+/*
+ * rcu_registry.hpp
+ *
+ *  Created on: 18 oct. 2026
+ */
+
+#ifndef DELEGATE_RCU_REGISTRY_HPP_
+#define DELEGATE_RCU_REGISTRY_HPP_
+
+#include "delegate/delegate.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+/**
+ * Registry of delegates read by many threads and rarely modified.
+ *
+ *   rcu_registry<void(const Packet&), 32> handlers;
+ *   auto h = handlers.add(Del::make<&Stats::onPacket>(stats)); // Control.
+ *
+ *   auto reader = handlers.make_reader();  // Once per dispatch thread.
+ *   handlers.emit(reader, packet);         // Every packet.
+ *
+ *   handlers.remove(h); // 'stats' may be destroyed when this return.
+ *
+ * Readers see an immutable snapshot of the delegates. Entering a read
+ * section is two relaxed stores, a fence and a load; no lock, no atomic
+ * read-modify-write, no loop. Readers never wait for writers.
+ *
+ * Writers are serialized by a mutex. They fill the spare of two snapshots,
+ * publish it, then wait for a grace period: until every reader that may
+ * still use the old snapshot has left its read section. Each reader owns a
+ * slot holding the global epoch when it entered, 0 when outside. After
+ * 'remove' return no thread is still calling the removed delegate, and the
+ * old snapshot can be reused by the next write.
+ *
+ * Constraints:
+ * - 'add', 'remove' and 'synchronize' wait for readers, they must not be
+ *   called from a read section, or from a callback, of the same thread.
+ * - A reader is used by one thread at a time, and must not outlive the
+ *   registry. Read sections of one reader may nest.
+ */
+
+#if __cplusplus < 201703L
+#error "Require at least C++17 to compile rcu_registry"
+#endif
+
+template <typename Sig, std::size_t N>
+class rcu_registry;
+
+template <typename R, typename... Args, std::size_t N>
+class rcu_registry<R(Args...), N>
+{
+    struct alignas(64) Slot
+    {
+        std::atomic<std::uint64_t> epoch{0};
+        std::atomic<bool> used{false};
+    };
+
+    struct Snapshot
+    {
+        std::size_t size = 0;
+        std::array<delegate<R(Args...)>, N> dels{};
+        std::array<std::uint32_t, N> ids{};
+    };
+
+  public:
+    using Del = delegate<R(Args...)>;
+
+    // Identify a registration. Value 0 is never used for a valid one.
+    using handle = std::uint32_t;
+
+    /**
+     * Registration of a reading thread, from 'make_reader'. Give back its
+     * slot when destroyed.
+     */
+    class reader
+    {
+      public:
+        reader(reader&& other) noexcept
+            : m_slot(other.m_slot), m_depth(other.m_depth)
+        {
+            other.m_slot = nullptr;
+        }
+        reader(const reader&) = delete;
+        reader& operator=(const reader&) = delete;
+        reader& operator=(reader&&) = delete;
+
+        ~reader()
+        {
+            if (m_slot)
+                m_slot->used.store(false, std::memory_order_release);
+        }
+
+        // False if there was no slot left.
+        bool valid() const noexcept
+        {
+            return m_slot != nullptr;
+        }
+
+      private:
+        friend class rcu_registry;
+        explicit reader(Slot* slot) noexcept : m_slot(slot) {}
+
+        Slot* m_slot;
+        unsigned m_depth = 0;
+    };
+
+    /**
+     * Read section over the current snapshot, left when destroyed.
+     * Iterate it to get the delegates.
+     */
+    class read_guard
+    {
+      public:
+        read_guard(const read_guard&) = delete;
+        read_guard& operator=(const read_guard&) = delete;
+
+        ~read_guard()
+        {
+            rcu_registry::exit(m_reader);
+        }
+
+        const Del* begin() const noexcept
+        {
+            return m_snapshot->dels.data();
+        }
+
+        const Del* end() const noexcept
+        {
+            return m_snapshot->dels.data() + m_snapshot->size;
+        }
+
+        std::size_t size() const noexcept
+        {
+            return m_snapshot->size;
+        }
+
+      private:
+        friend class rcu_registry;
+        read_guard(reader& r, const Snapshot* snapshot) noexcept
+            : m_reader(r), m_snapshot(snapshot)
+        {
+        }
+
+        reader& m_reader;
+        const Snapshot* m_snapshot;
+    };
+
+    explicit rcu_registry(std::size_t maxReaders = 64)
+        : m_slots(new Slot[maxReaders]), m_maxReaders(maxReaders)
+    {
+    }
+
+    rcu_registry(const rcu_registry&) = delete;
+    rcu_registry& operator=(const rcu_registry&) = delete;
+
+    // Claim a reader slot. Check 'valid', there are 'maxReaders' slots.
+    reader make_reader() noexcept
+    {
+        for (std::size_t i = 0; i < m_maxReaders; ++i)
+        {
+            bool expected = false;
+            if (!m_slots[i].used.load(std::memory_order_relaxed) &&
+                m_slots[i].used.compare_exchange_strong(
+                    expected, true, std::memory_order_acquire))
+                return reader{&m_slots[i]};
+        }
+        return reader{nullptr};
+    }
+
+    /**
+     * Add a delegate, visible to read sections entered after the call.
+     * Return 0 if the registry is full.
+     */
+    handle add(Del del)
+    {
+        std::lock_guard<std::mutex> lock(m_writeLock);
+        const Snapshot& cur = *m_current.load(std::memory_order_relaxed);
+        if (cur.size == N)
+            return 0;
+
+        Snapshot& next = spare(cur);
+        copyFrom(next, cur, cur.size);
+        if (++m_lastHandle == 0)
+            ++m_lastHandle;
+        next.dels[cur.size] = del;
+        next.ids[cur.size] = m_lastHandle;
+        next.size = cur.size + 1;
+        publish(next);
+        return m_lastHandle;
+    }
+
+    /**
+     * Remove a delegate. When this return no thread is still calling it.
+     * Return false if 'h' is not registered.
+     */
+    bool remove(handle h)
+    {
+        std::lock_guard<std::mutex> lock(m_writeLock);
+        const Snapshot& cur = *m_current.load(std::memory_order_relaxed);
+        auto ids = cur.ids.data();
+        auto pos = std::find(ids, ids + cur.size, h);
+        if (h == 0 || pos == ids + cur.size)
+            return false;
+
+        auto index = static_cast<std::size_t>(pos - ids);
+        Snapshot& next = spare(cur);
+        copyFrom(next, cur, index);
+        std::copy(cur.dels.data() + index + 1, cur.dels.data() + cur.size,
+                  next.dels.data() + index);
+        std::copy(ids + index + 1, ids + cur.size, next.ids.data() + index);
+        next.size = cur.size - 1;
+        publish(next);
+        return true;
+    }
+
+    // Wait until all read sections entered before the call have ended.
+    void synchronize()
+    {
+        std::lock_guard<std::mutex> lock(m_writeLock);
+        waitForReaders();
+    }
+
+    // Enter a read section on the current snapshot.
+    read_guard read(reader& r) const noexcept
+    {
+        return read_guard{r, enter(r)};
+    }
+
+    // Call all delegates of the current snapshot.
+    void emit(reader& r, Args... args) const
+    {
+        auto guard = read(r);
+        for (auto& d : guard)
+            d(args...);
+    }
+
+    // Number of delegates in the current snapshot.
+    std::size_t size() const noexcept
+    {
+        return m_current.load(std::memory_order_acquire)->size;
+    }
+
+    static constexpr std::size_t capacity() noexcept
+    {
+        return N;
+    }
+
+  private:
+    const Snapshot* enter(reader& r) const noexcept
+    {
+        if (r.m_depth++ == 0)
+        {
+            auto epoch = m_epoch.load(std::memory_order_relaxed);
+            r.m_slot->epoch.store(epoch, std::memory_order_relaxed);
+            // Pair with the fence in 'waitForReaders': either the writer
+            // see this slot, or this reader see the new snapshot.
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+        }
+        return m_current.load(std::memory_order_acquire);
+    }
+
+    static void exit(reader& r) noexcept
+    {
+        if (--r.m_depth == 0)
+            r.m_slot->epoch.store(0, std::memory_order_release);
+    }
+
+    Snapshot& spare(const Snapshot& cur) noexcept
+    {
+        return &cur == &m_snapshots[0] ? m_snapshots[1] : m_snapshots[0];
+    }
+
+    static void copyFrom(Snapshot& to, const Snapshot& from, std::size_t n)
+    {
+        std::copy(from.dels.data(), from.dels.data() + n, to.dels.data());
+        std::copy(from.ids.data(), from.ids.data() + n, to.ids.data());
+    }
+
+    // Make 'next' current, then wait until nobody use the previous one.
+    void publish(const Snapshot& next)
+    {
+        m_current.store(&next, std::memory_order_release);
+        waitForReaders();
+    }
+
+    /**
+     * Readers which entered with an epoch below the new one may hold the
+     * previous snapshot. Readers seeing the new epoch, or entering after
+     * the fence, see the new snapshot.
+     */
+    void waitForReaders()
+    {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        auto epoch = m_epoch.load(std::memory_order_relaxed) + 1;
+        m_epoch.store(epoch, std::memory_order_relaxed);
+        for (std::size_t i = 0; i < m_maxReaders; ++i)
+        {
+            for (;;)
+            {
+                auto e = m_slots[i].epoch.load(std::memory_order_acquire);
+                if (e == 0 || e >= epoch)
+                    break;
+                std::this_thread::yield();
+            }
+        }
+    }
+
+    Snapshot m_snapshots[2];
+    std::atomic<const Snapshot*> m_current{&m_snapshots[0]};
+    std::atomic<std::uint64_t> m_epoch{1};
+    std::unique_ptr<Slot[]> m_slots;
+    std::size_t m_maxReaders;
+    std::mutex m_writeLock;
+    handle m_lastHandle = 0;
+};
+
+#endif /* DELEGATE_RCU_REGISTRY_HPP_ */
@@ -0,0 +1,172 @@
+/*
+ * relocation.hpp
+ *
+ *  Created on: 18 oct. 2026
+ */
+
+#ifndef DELEGATE_RELOCATION_HPP_
+#define DELEGATE_RELOCATION_HPP_
+
+#include "delegate/delegate.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * Rebase delegates when the objects they call into are moved, to compact
+ * object pools without rebuilding the callbacks.
+ *
+ *   relocation_registry registry;
+ *   registry.add(timerCallbacks);  // Any range of delegates, e.g. a vector.
+ *   registry.add(onClose);         // Or a single delegate.
+ *
+ *   // While compacting the pool, after moving the objects:
+ *   relocation moves[] = {{oldA, newA, sizeof(Obj)}, {oldB, newB, 64}};
+ *   registry.relocate(moves, 2);
+ *
+ * A rule (old base, new base, length) applies to every registered delegate
+ * whose context, see delegate::context, is in [old base, old base + length):
+ * the context moves by the same offset. Delegates to free functions, and
+ * delegates pointing elsewhere, are left untouched.
+ *
+ * Containers are walked through begin() and end() on every relocate, they
+ * may grow or shrink between calls but must outlive their registration.
+ * Old ranges of one relocate must not overlap. Nothing is synchronized: no
+ * delegate may be called or modified during 'relocate'.
+ */
+
+struct relocation
+{
+    const void* old_base;
+    const void* new_base;
+    std::size_t length;
+};
+
+namespace details
+{
+inline bool
+relocationBefore(const relocation& lhs, const relocation& rhs) noexcept
+{
+    return reinterpret_cast<std::uintptr_t>(lhs.old_base) <
+           reinterpret_cast<std::uintptr_t>(rhs.old_base);
+}
+
+// Apply the rule containing the context of 'del', 'rules' sorted by
+// old_base.
+template <typename Del>
+bool
+relocateOne(Del& del, const relocation* rules, std::size_t n) noexcept
+{
+    if (!del.context())
+        return false;
+    relocation key{del.context(), nullptr, 0};
+    auto pos = std::upper_bound(rules, rules + n, key, relocationBefore);
+    if (pos == rules)
+        return false;
+    --pos;
+    return del.rebase(pos->old_base, pos->new_base, pos->length);
+}
+
+template <typename Container>
+std::size_t
+relocateRange(void* target, const relocation* rules, std::size_t n)
+{
+    std::size_t count = 0;
+    for (auto& del : *static_cast<Container*>(target))
+        count += relocateOne(del, rules, n) ? 1 : 0;
+    return count;
+}
+
+template <typename Del>
+std::size_t
+relocateSingle(void* target, const relocation* rules, std::size_t n)
+{
+    return relocateOne(*static_cast<Del*>(target), rules, n) ? 1 : 0;
+}
+} // namespace details
+
+class relocation_registry
+{
+  public:
+    // Identify a registration. Value 0 is never used for a valid one.
+    using handle = std::uint32_t;
+
+    /**
+     * Register a range of delegates, any signature, iterated with mutable
+     * references.
+     */
+    template <typename Container>
+    handle add(Container& delegates)
+    {
+        return insert(&delegates, &details::relocateRange<Container>);
+    }
+
+    template <typename R, typename... Args>
+    handle add(delegate<R(Args...)>& del)
+    {
+        return insert(&del, &details::relocateSingle<delegate<R(Args...)>>);
+    }
+
+    // Return false if 'h' is not registered.
+    bool remove(handle h)
+    {
+        auto pos = std::find_if(m_entries.begin(), m_entries.end(),
+                                [h](const Entry& e) { return e.id == h; });
+        if (h == 0 || pos == m_entries.end())
+            return false;
+        m_entries.erase(pos);
+        return true;
+    }
+
+    /**
+     * Apply 'n' rules to all registered delegates. Return the number of
+     * delegates rebased.
+     */
+    std::size_t relocate(const relocation* rules, std::size_t n)
+    {
+        m_sorted.assign(rules, rules + n);
+        std::sort(m_sorted.begin(), m_sorted.end(),
+                  details::relocationBefore);
+        std::size_t count = 0;
+        for (auto& e : m_entries)
+            count += e.relocate(e.target, m_sorted.data(), n);
+        return count;
+    }
+
+    std::size_t relocate(const relocation& rule)
+    {
+        return relocate(&rule, 1);
+    }
+
+    // Number of registrations.
+    std::size_t size() const noexcept
+    {
+        return m_entries.size();
+    }
+
+  private:
+    using Relocate = std::size_t (*)(void*, const relocation*, std::size_t);
+
+    struct Entry
+    {
+        handle id;
+        void* target;
+        Relocate relocate;
+    };
+
+    handle insert(void* target, Relocate relocate)
+    {
+        if (++m_lastHandle == 0)
+            ++m_lastHandle;
+        m_entries.push_back(Entry{m_lastHandle, target, relocate});
+        return m_lastHandle;
+    }
+
+    std::vector<Entry> m_entries;
+    std::vector<relocation> m_sorted;
+    handle m_lastHandle = 0;
+};
+
+#endif /* DELEGATE_RELOCATION_HPP_ */
@@ -0,0 +1,204 @@
+/*
+ * sharded_signal.hpp
+ *
+ *  Created on: 18 oct. 2026
+ */
+
+#ifndef DELEGATE_SHARDED_SIGNAL_HPP_
+#define DELEGATE_SHARDED_SIGNAL_HPP_
+
+#include "delegate/delegate.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+#if defined(__linux__)
+#include <sched.h>
+#endif
+
+/**
+ * Signal with one subscriber list per CPU, for many threads connecting and
+ * disconnecting at a high rate.
+ *
+ *   sharded_signal<void(const Order&), 64> onOrder;
+ *   auto h = onOrder.connect(Del::make<&Book::onOrder>(book)); // Any thread.
+ *   onOrder.emit(order);
+ *   onOrder.disconnect(h);
+ *
+ * Each shard is cache line aligned with its own lock and a dense array of
+ * up to PerShard delegates. 'connect' adds to the shard of the CPU running
+ * the caller, or the next one with room, so threads on different CPUs do
+ * not contend. The handle encodes the shard, 'disconnect' only locks that
+ * shard. 'emit' walks all shards, locking each while calling its
+ * subscribers, and skips empty shards without locking.
+ *
+ * Subscribers are called in no particular order. A subscriber connected
+ * or disconnected during an emit may or may not be called by it.
+ * Subscribers must not connect to or disconnect from the signal calling
+ * them.
+ */
+
+#if __cplusplus < 201703L
+#error "Require at least C++17 to compile sharded_signal"
+#endif
+
+template <typename Sig, std::size_t PerShard = 64>
+class sharded_signal;
+
+template <typename R, typename... Args, std::size_t PerShard>
+class sharded_signal<R(Args...), PerShard>
+{
+  public:
+    using Del = delegate<R(Args...)>;
+
+    /**
+     * Identify a connection. The shard index is in the top 16 bits, a per
+     * shard counter in the others. Value 0 is never used for a valid
+     * connection.
+     */
+    using handle = std::uint64_t;
+
+    static constexpr unsigned shardBits = 48;
+
+    // 'shards' defaults to the number of CPUs, at most 65536.
+    explicit sharded_signal(std::size_t shards = 0)
+        : m_shardCount(std::min<std::size_t>(shards ? shards : defaultShards(),
+                                             std::size_t{1} << 16)),
+          m_shards(new Shard[m_shardCount])
+    {
+    }
+
+    sharded_signal(const sharded_signal&) = delete;
+    sharded_signal& operator=(const sharded_signal&) = delete;
+
+    /**
+     * Add a subscriber to the shard of the current CPU, or the next shard
+     * with room. Return 0 if all shards are full.
+     */
+    handle connect(Del del)
+    {
+        auto first = localShard();
+        for (std::size_t i = 0; i < m_shardCount; ++i)
+        {
+            auto index = (first + i) % m_shardCount;
+            Shard& s = m_shards[index];
+            std::lock_guard<std::mutex> lock(s.lock);
+            auto size = s.size.load(std::memory_order_relaxed);
+            if (size == PerShard)
+                continue;
+            if (++s.lastId == (std::uint64_t{1} << shardBits))
+                s.lastId = 1;
+            s.dels[size] = del;
+            s.ids[size] = s.lastId;
+            s.size.store(size + 1, std::memory_order_release);
+            return (static_cast<handle>(index) << shardBits) | s.lastId;
+        }
+        return 0;
+    }
+
+    // Remove a subscriber. Return false if not connected.
+    bool disconnect(handle h)
+    {
+        auto index = shard_of(h);
+        if (h == 0 || index >= m_shardCount)
+            return false;
+
+        auto id = h & ((std::uint64_t{1} << shardBits) - 1);
+        Shard& s = m_shards[index];
+        std::lock_guard<std::mutex> lock(s.lock);
+        auto size = s.size.load(std::memory_order_relaxed);
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            if (s.ids[i] == id)
+            {
+                // Keep the array dense, order does not matter.
+                s.dels[i] = s.dels[size - 1];
+                s.ids[i] = s.ids[size - 1];
+                s.dels[size - 1].clear();
+                s.size.store(size - 1, std::memory_order_release);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Call all subscribers.
+    void emit(Args... args) const
+    {
+        for (std::size_t i = 0; i < m_shardCount; ++i)
+        {
+            Shard& s = m_shards[i];
+            if (s.size.load(std::memory_order_acquire) == 0)
+                continue;
+            std::lock_guard<std::mutex> lock(s.lock);
+            auto size = s.size.load(std::memory_order_relaxed);
+            for (std::size_t j = 0; j < size; ++j)
+                s.dels[j](args...);
+        }
+    }
+
+    void operator()(Args... args) const
+    {
+        emit(args...);
+    }
+
+    // Number of subscribers, may be outdated when returned.
+    std::size_t size() const noexcept
+    {
+        std::size_t n = 0;
+        for (std::size_t i = 0; i < m_shardCount; ++i)
+            n += m_shards[i].size.load(std::memory_order_relaxed);
+        return n;
+    }
+
+    std::size_t shard_count() const noexcept
+    {
+        return m_shardCount;
+    }
+
+    static constexpr std::size_t shard_of(handle h) noexcept
+    {
+        return static_cast<std::size_t>(h >> shardBits);
+    }
+
+  private:
+    struct alignas(64) Shard
+    {
+        std::mutex lock;
+        std::atomic<std::size_t> size{0};
+        std::uint64_t lastId = 0;
+        std::array<Del, PerShard> dels{};
+        std::array<std::uint64_t, PerShard> ids{};
+    };
+
+    static std::size_t defaultShards() noexcept
+    {
+        auto n = std::thread::hardware_concurrency();
+        return n ? n : 1;
+    }
+
+    // Shard of the CPU running the caller, a hash of the thread id if
+    // unknown.
+    std::size_t localShard() const noexcept
+    {
+#if defined(__linux__)
+        int cpu = sched_getcpu();
+        if (cpu >= 0)
+            return static_cast<std::size_t>(cpu) % m_shardCount;
+#endif
+        auto id = std::hash<std::thread::id>{}(std::this_thread::get_id());
+        return id % m_shardCount;
+    }
+
+    std::size_t m_shardCount;
+    std::unique_ptr<Shard[]> m_shards;
+};
+
+#endif /* DELEGATE_SHARDED_SIGNAL_HPP_ */
@@ -0,0 +1,274 @@
+/*
+ * shm_delegate.hpp
+ *
+ *  Created on: 18 oct. 2026
+ */
+
+#ifndef DELEGATE_SHM_DELEGATE_HPP_
+#define DELEGATE_SHM_DELEGATE_HPP_
+
+#include "delegate/buffer_invoke.hpp"
+#include "delegate/delegate.hpp"
+#include "delegate/static_signal.hpp"
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+/**
+ * Delegates that can be stored in memory shared between processes.
+ *
+ * A delegate holds the address of a trampoline and of an object. Both differ
+ * between processes, because of ASLR and because a shared region is not
+ * mapped at the same address everywhere. An 'shm_delegate' holds instead:
+ * - the id of the member function, its index in an 'shm_registry',
+ * - the offset of the object from the base of the shared region.
+ *
+ * The registry is a compile time list of member functions. All processes
+ * must use the same list, in the same order:
+ *
+ *   using Registry = shm_registry<&Account::deposit, &Account::withdraw>;
+ *
+ *   // Process A, 'base' is where the region is mapped in A.
+ *   auto d = Registry::make<&Account::deposit>(base, *account);
+ *   queue->try_post(d, 100);
+ *
+ *   // Process B.
+ *   queue->poll<Registry>(base, size); // Call Account::deposit(100).
+ *
+ * 'resolve' turns an shm_delegate back into a delegate for the region of
+ * 'length' bytes mapped at 'base' in the current process. The region may be
+ * written by another, untrusted, process: ids out of range, and offsets not
+ * leaving room for an aligned object inside the region, resolve to a null
+ * delegate.
+ *
+ * 'shm_queue' is a bounded lock-free queue of calls, arguments encoded with
+ * buffer_invoke. It has no pointers and can be placed in the shared region.
+ */
+
+#if __cplusplus < 201703L
+#error "Require at least C++17 to compile shm_delegate"
+#endif
+
+template <typename Sig>
+struct shm_delegate
+{
+    static constexpr std::uint32_t invalid = ~std::uint32_t{0};
+
+    std::uint32_t id = invalid;
+    std::uint64_t offset = 0;
+};
+
+namespace details
+{
+template <typename Sig, auto... mFkns>
+class ShmRegistry;
+
+template <typename R, typename... Args, auto... mFkns>
+class ShmRegistry<R(Args...), mFkns...>
+{
+  public:
+    using Del = delegate<R(Args...)>;
+    using Shm = shm_delegate<R(Args...)>;
+
+  private:
+    template <auto mFkn>
+    using DM = typename Del::template DeduceMemberType<decltype(mFkn), mFkn>;
+
+  public:
+    static_assert((std::is_member_function_pointer<decltype(mFkns)>::value &&
+                   ...),
+                  "shm_registry only accept member functions");
+
+    static constexpr std::size_t size() noexcept
+    {
+        return sizeof...(mFkns);
+    }
+
+    // Id of 'mFkn', a compile error if not registered.
+    template <auto mFkn>
+    static constexpr std::uint32_t id() noexcept
+    {
+        constexpr std::uint32_t res = indexOf<mFkn>();
+        static_assert(res != Shm::invalid, "Member function not registered");
+        return res;
+    }
+
+    // Object 'obj' must be inside the region starting at 'base'.
+    template <auto mFkn>
+    static Shm make(const void* base, const typename DM<mFkn>::ObjType& obj)
+    {
+        auto offset = reinterpret_cast<const char*>(&obj) -
+                      static_cast<const char*>(base);
+        return Shm{id<mFkn>(), static_cast<std::uint64_t>(offset)};
+    }
+
+    // Null if 'd' does not name an object inside the region.
+    static Del resolve(const Shm& d, void* base, std::size_t length) noexcept
+    {
+        if (d.id >= size() || d.offset > length ||
+            length - d.offset < objectSizes[d.id] ||
+            d.offset % objectAligns[d.id] != 0)
+            return Del{};
+        return Del::makeVoidCB(trampolines[d.id],
+                               static_cast<char*>(base) + d.offset);
+    }
+
+  private:
+    template <auto mFkn>
+    static constexpr std::uint32_t indexOf() noexcept
+    {
+        std::uint32_t res = Shm::invalid;
+        std::uint32_t i = 0;
+        ((res = (res == Shm::invalid && isSame<mFkn, mFkns>()) ? i : res, ++i),
+         ...);
+        return res;
+    }
+
+    template <auto a, auto b>
+    static constexpr bool isSame() noexcept
+    {
+        if constexpr (std::is_same<decltype(a), decltype(b)>::value)
+            return a == b;
+        else
+            return false;
+    }
+
+    template <auto mFkn>
+    using TrampolineOf = std::remove_const_t<decltype(DM<mFkn>::trampoline)>;
+    using Trampoline =
+        std::tuple_element_t<0, std::tuple<TrampolineOf<mFkns>...>>;
+
+    static constexpr std::array<Trampoline, sizeof...(mFkns)> trampolines{
+        DM<mFkns>::trampoline...};
+    static constexpr std::array<std::size_t, sizeof...(mFkns)> objectSizes{
+        sizeof(typename DM<mFkns>::ObjType)...};
+    static constexpr std::array<std::size_t, sizeof...(mFkns)> objectAligns{
+        alignof(typename DM<mFkns>::ObjType)...};
+};
+} // namespace details
+
+/**
+ * Compile time list of member functions with the same signature, giving
+ * each a stable id.
+ */
+template <auto mFkn, auto... mFkns>
+using shm_registry =
+    details::ShmRegistry<typename details::SignatureOf<decltype(mFkn)>::type,
+                         mFkn, mFkns...>;
+
+/**
+ * Bounded multi producer multi consumer queue of calls, with N a power of 2.
+ * Safe to place in memory shared between processes: it only holds offsets,
+ * ids and lock-free atomics. Construct it once in the region, e.g. with
+ * placement new, before other processes use it.
+ */
+template <typename Sig, std::size_t N>
+class shm_queue;
+
+template <typename R, typename... Args, std::size_t N>
+class shm_queue<R(Args...), N>
+{
+  public:
+    using Shm = shm_delegate<R(Args...)>;
+
+    static_assert(N != 0 && (N & (N - 1)) == 0, "N must be a power of 2");
+    static_assert(std::atomic<std::uint64_t>::is_always_lock_free,
+                  "Shared memory queue require lock-free 64 bits atomics");
+
+    shm_queue() noexcept
+    {
+        for (std::size_t i = 0; i < N; ++i)
+            m_cells[i].seq.store(i, std::memory_order_relaxed);
+    }
+
+    shm_queue(const shm_queue&) = delete;
+    shm_queue& operator=(const shm_queue&) = delete;
+
+    // Queue a call of 'd' with 'args'. Return false if the queue is full.
+    template <typename... Ts>
+    bool try_post(const Shm& d, Ts&&... args) noexcept
+    {
+        auto pos = m_enqueue.load(std::memory_order_relaxed);
+        Cell* cell;
+        for (;;)
+        {
+            cell = &m_cells[pos % N];
+            auto seq = cell->seq.load(std::memory_order_acquire);
+            auto diff = static_cast<std::int64_t>(seq - pos);
+            if (diff == 0)
+            {
+                if (m_enqueue.compare_exchange_weak(pos, pos + 1,
+                                                    std::memory_order_relaxed))
+                    break;
+            }
+            else if (diff < 0)
+                return false;
+            else
+                pos = m_enqueue.load(std::memory_order_relaxed);
+        }
+        cell->del = d;
+        encode_call<R(Args...)>(cell->args, sizeof(cell->args),
+                                std::forward<Ts>(args)...);
+        cell->seq.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * Run up to 'max' queued calls, resolving delegates with 'Registry' for
+     * the region of 'size' bytes mapped at 'base'. Return the number of
+     * calls, invalid delegates included.
+     */
+    template <typename Registry>
+    std::size_t poll(void* base, std::size_t size,
+                     std::size_t max = ~std::size_t{0})
+    {
+        std::size_t n = 0;
+        while (n < max)
+        {
+            auto pos = m_dequeue.load(std::memory_order_relaxed);
+            Cell* cell = &m_cells[pos % N];
+            auto seq = cell->seq.load(std::memory_order_acquire);
+            auto diff = static_cast<std::int64_t>(seq - (pos + 1));
+            if (diff < 0)
+                break;
+            if (diff > 0 ||
+                !m_dequeue.compare_exchange_weak(pos, pos + 1,
+                                                 std::memory_order_relaxed))
+                continue;
+
+            // Copy out, so the cell can be reused while the call run.
+            Shm d = cell->del;
+            std::byte args[sizeof(cell->args)];
+            std::memcpy(args, cell->args, sizeof(args));
+            cell->seq.store(pos + N, std::memory_order_release);
+            invoke_from_buffer(Registry::resolve(d, base, size), args,
+                               sizeof(args));
+            ++n;
+        }
+        return n;
+    }
+
+  private:
+    // At least one byte, so argument-less calls have a valid array.
+    static constexpr std::size_t argsSize =
+        encoded_size<R(Args...)>() ? encoded_size<R(Args...)>() : 1;
+
+    struct alignas(64) Cell
+    {
+        std::atomic<std::uint64_t> seq;
+        Shm del;
+        std::byte args[argsSize];
+    };
+
+    alignas(64) std::atomic<std::uint64_t> m_enqueue{0};
+    alignas(64) std::atomic<std::uint64_t> m_dequeue{0};
+    Cell m_cells[N];
+};
+
+#endif /* DELEGATE_SHM_DELEGATE_HPP_ */
@@ -0,0 +1,204 @@
+/*
+ * static_signal.hpp
+ *
+ *  Created on: 18 oct. 2026
+ */
+
+#ifndef DELEGATE_STATIC_SIGNAL_HPP_
+#define DELEGATE_STATIC_SIGNAL_HPP_
+
+#include "delegate/delegate.hpp"
+
+#include <array>
+#include <cstddef>
+#include <tuple>
+#include <type_traits>
+
+/**
+ * Signal where the list of subscribers is fixed at compile time.
+ *
+ * Each subscriber is given as a non type template argument, either a free
+ * function or a member function:
+ *
+ *   static_signal<&A::onTick, &B::onTick, freeOnTick> sig;
+ *   sig.bind<&A::onTick>(a);
+ *   sig.bind<&B::onTick>(b);
+ *   sig.emit(123);
+ *
+ * Emit expands to one direct call per subscriber. There is no trampoline
+ * involved so the optimizer can inline all of them.
+ * Member functions need an object before they are called. Until bound they
+ * are skipped, in the same spirit as calling a null delegate.
+ *
+ * The signal only stores pointers to bound objects. As for delegate, the user
+ * must keep them alive.
+ *
+ * For debugging, 'to_delegates' return the same subscribers as an array of
+ * runtime delegates.
+ */
+
+#if __cplusplus < 201703L
+#error "Require at least C++17 to compile static_signal"
+#endif
+
+namespace details
+{
+// Deduce the delegate signature from a free or member function pointer.
+template <typename T>
+struct SignatureOf;
+
+template <typename R, typename... Args>
+struct SignatureOf<R (*)(Args...)>
+{
+    using type = R(Args...);
+};
+
+template <typename R, typename T, typename... Args>
+struct SignatureOf<R (T::*)(Args...)>
+{
+    using type = R(Args...);
+};
+
+template <typename R, typename T, typename... Args>
+struct SignatureOf<R (T::*)(Args...) const>
+{
+    using type = R(Args...);
+};
+
+// One subscriber in a static_signal. Free functions need no storage.
+template <typename Del, auto fkn,
+          bool member = std::is_member_function_pointer<decltype(fkn)>::value>
+struct StaticSlot
+{
+    template <typename... Args>
+    constexpr void call(Args&... args) const
+    {
+        fkn(args...);
+    }
+
+    constexpr Del toDelegate() const noexcept
+    {
+        return Del::template make<fkn>();
+    }
+};
+
+// Member function subscriber. Store a pointer to the bound object.
+template <typename Del, auto fkn>
+struct StaticSlot<Del, fkn, true>
+{
+    using DM = typename Del::template DeduceMemberType<decltype(fkn), fkn>;
+    using ObjType = typename DM::ObjType;
+    using ObjRef = std::conditional_t<DM::cnst, ObjType const&, ObjType&>;
+
+    template <typename... Args>
+    constexpr void call(Args&... args) const
+    {
+        if (obj)
+            (obj->*fkn)(args...);
+    }
+
+    constexpr Del toDelegate() const noexcept
+    {
+        return obj ? Del::template make<fkn>(*obj) : Del{};
+    }
+
+    std::remove_reference_t<ObjRef>* obj = nullptr;
+};
+
+template <typename Sig, auto... fkns>
+class StaticSignal;
+
+template <typename R, typename... Args, auto... fkns>
+class StaticSignal<R(Args...), fkns...>
+{
+  public:
+    using Del = delegate<R(Args...)>;
+
+    static_assert(
+        (std::is_same<typename SignatureOf<decltype(fkns)>::type,
+                      R(Args...)>::value &&
+         ...),
+        "All subscribers of a static_signal must have the same signature");
+
+    static constexpr std::size_t size() noexcept
+    {
+        return sizeof...(fkns);
+    }
+
+    /**
+     * Bind an object to every subscriber slot using member function mFkn.
+     * Non const member functions require a non const object.
+     */
+    template <auto mFkn>
+    constexpr StaticSignal&
+    bind(typename StaticSlot<Del, mFkn>::ObjRef obj) noexcept
+    {
+        setObject<mFkn>(&obj, std::index_sequence_for<decltype(fkns)...>{});
+        return *this;
+    }
+
+    // Do not allow temporaries to be stored.
+    template <auto mFkn>
+    constexpr StaticSignal&
+    bind(typename StaticSlot<Del, mFkn>::ObjType&&) = delete;
+
+    template <auto mFkn>
+    constexpr StaticSignal& unbind() noexcept
+    {
+        setObject<mFkn>(nullptr, std::index_sequence_for<decltype(fkns)...>{});
+        return *this;
+    }
+
+    // Call all subscribers in declaration order. Return values are discarded.
+    constexpr void emit(Args... args) const
+    {
+        std::apply([&](auto const&... slot) { (slot.call(args...), ...); },
+                   m_slots);
+    }
+
+    constexpr void operator()(Args... args) const
+    {
+        emit(args...);
+    }
+
+    // Runtime equivalent of the subscriber list. Unbound members are null.
+    constexpr std::array<Del, sizeof...(fkns)> to_delegates() const noexcept
+    {
+        return std::apply(
+            [](auto const&... slot) {
+                return std::array<Del, sizeof...(fkns)>{slot.toDelegate()...};
+            },
+            m_slots);
+    }
+
+  private:
+    template <auto mFkn, std::size_t... I>
+    constexpr void
+    setObject(std::remove_reference_t<typename StaticSlot<Del, mFkn>::ObjRef>*
+                  obj,
+              std::index_sequence<I...>) noexcept
+    {
+        (setSlot<mFkn, I>(obj), ...);
+    }
+
+    template <auto mFkn, std::size_t I, typename Ptr>
+    constexpr void setSlot(Ptr obj) noexcept
+    {
+        using Fkn = std::tuple_element_t<I, std::tuple<decltype(fkns)...>>;
+        if constexpr (std::is_same<Fkn, decltype(mFkn)>::value)
+        {
+            if (std::get<I>(std::make_tuple(fkns...)) == mFkn)
+                std::get<I>(m_slots).obj = obj;
+        }
+    }
+
+    std::tuple<StaticSlot<Del, fkns>...> m_slots;
+};
+} // namespace details
+
+template <auto fkn, auto... fkns>
+using static_signal =
+    details::StaticSignal<typename details::SignatureOf<decltype(fkn)>::type,
+                          fkn, fkns...>;
+
+#endif /* DELEGATE_STATIC_SIGNAL_HPP_ */
@@ -0,0 +1,305 @@
+/*
+ * task_graph.hpp
+ *
+ *  Created on: 18 oct. 2026
+ */
+
+#ifndef DELEGATE_TASK_GRAPH_HPP_
+#define DELEGATE_TASK_GRAPH_HPP_
+
+#include "delegate/delegate.hpp"
+#include "delegate/thread_pool.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+/**
+ * Directed acyclic graph of delegate<void()> tasks run on a thread_pool.
+ *
+ *   task_graph graph;
+ *   auto input = graph.add(Task::make<&Input::poll>(input));
+ *   auto physics = graph.add(Task::make<&Physics::step>(physics));
+ *   auto render = graph.add(Task::make<&Renderer::draw>(renderer));
+ *   graph.precede(input, physics);
+ *   graph.precede(physics, render);
+ *   graph.run(pool); // Every frame.
+ *
+ * Edges are stored in flat arrays (compressed sparse rows) built on the
+ * first run after the graph changed. Each node has an atomic count of
+ * unfinished predecessors, the node finishing last a predecessor makes the
+ * successor ready. The first ready successor is run by the same thread,
+ * others are handed to the pool. Running the same graph again does not
+ * allocate.
+ *
+ * With 'set_timing(true)' the start and end time of every node are recorded,
+ * relative to the start of the run, and 'critical_path' returns the longest
+ * chain of dependent nodes of the last run.
+ *
+ * The graph must not be modified while it is running, and 'run' must not be
+ * called concurrently on the same graph.
+ */
+
+#if __cplusplus < 201703L
+#error "Require at least C++17 to compile task_graph"
+#endif
+
+class task_graph
+{
+  public:
+    using Task = delegate<void()>;
+    using node_id = std::uint32_t;
+
+    struct node_time
+    {
+        // Nanoseconds since the start of the run.
+        std::uint64_t start = 0;
+        std::uint64_t end = 0;
+    };
+
+    task_graph() = default;
+    task_graph(const task_graph&) = delete;
+    task_graph& operator=(const task_graph&) = delete;
+
+    node_id add(Task task)
+    {
+        m_tasks.push_back(task);
+        m_compiled = false;
+        return static_cast<node_id>(m_tasks.size() - 1);
+    }
+
+    /**
+     * 'after' will only start once 'before' has finished. Return false,
+     * adding nothing, if either is not a node of this graph.
+     */
+    bool precede(node_id before, node_id after)
+    {
+        if (before >= m_tasks.size() || after >= m_tasks.size())
+            return false;
+        m_edges.emplace_back(before, after);
+        m_compiled = false;
+        return true;
+    }
+
+    /**
+     * Run all tasks and return once they have all finished. The calling
+     * thread take part in the work. Return false, without running anything,
+     * if the graph has a cycle.
+     */
+    bool run(thread_pool& pool)
+    {
+        if (!m_compiled)
+            compile();
+        if (m_order.size() != m_tasks.size())
+            return false;
+        if (m_tasks.empty())
+            return true;
+
+        for (std::size_t i = 0; i < m_tasks.size(); ++i)
+            m_pending[i].store(m_indegree[i], std::memory_order_relaxed);
+        delegate_latch done{static_cast<std::ptrdiff_t>(m_tasks.size())};
+        m_pool = &pool;
+        m_done = &done;
+        m_epoch = Clock::now();
+
+        // Roots are first in the topological order.
+        std::size_t roots = 0;
+        while (roots < m_order.size() && m_indegree[m_order[roots]] == 0)
+            ++roots;
+        for (std::size_t i = 1; i < roots; ++i)
+            if (!pool.try_submit(Task::make(m_runners[m_order[i]])))
+                execute(m_order[i]);
+        execute(m_order[0]);
+        pool.wait(done);
+        m_pool = nullptr;
+        m_done = nullptr;
+        return true;
+    }
+
+    void set_timing(bool enable) noexcept
+    {
+        m_timing = enable;
+    }
+
+    // Timing of 'node' during the last run with timing enabled.
+    node_time time(node_id node) const noexcept
+    {
+        return m_times[node];
+    }
+
+    /**
+     * Store in 'path' the chain of dependent nodes with the longest total
+     * duration in the last timed run, from root to leaf. Return that
+     * duration in nanoseconds.
+     */
+    std::uint64_t critical_path(std::vector<node_id>& path)
+    {
+        path.clear();
+        if (m_times.empty() || m_order.size() != m_tasks.size())
+            return 0;
+
+        std::uint64_t best = 0;
+        node_id last = 0;
+        for (std::size_t i = 0; i < m_tasks.size(); ++i)
+        {
+            m_pathLength[i] = 0;
+            m_pathParent[i] = noNode;
+        }
+        for (node_id n : m_order)
+        {
+            const auto& t = m_times[n];
+            std::uint64_t length = m_pathLength[n] + (t.end - t.start);
+            if (length >= best)
+            {
+                best = length;
+                last = n;
+            }
+            for (auto e = m_firstSucc[n]; e != m_firstSucc[n + 1]; ++e)
+            {
+                node_id s = m_succ[e];
+                if (m_pathParent[s] == noNode || length > m_pathLength[s])
+                {
+                    m_pathLength[s] = length;
+                    m_pathParent[s] = n;
+                }
+            }
+        }
+        for (node_id n = last; n != noNode; n = m_pathParent[n])
+            path.push_back(n);
+        for (std::size_t i = 0, j = path.size(); i + 1 < j; ++i, --j)
+            std::swap(path[i], path[j - 1]);
+        return best;
+    }
+
+    std::size_t size() const noexcept
+    {
+        return m_tasks.size();
+    }
+
+  private:
+    using Clock = std::chrono::steady_clock;
+
+    static constexpr node_id noNode = ~node_id{0};
+
+    struct Runner
+    {
+        void operator()() const
+        {
+            graph->execute(node);
+        }
+        task_graph* graph;
+        node_id node;
+    };
+
+    // Build the successor arrays and a topological order.
+    void compile()
+    {
+        auto n = m_tasks.size();
+        m_firstSucc.assign(n + 1, 0);
+        m_indegree.assign(n, 0);
+        for (auto& e : m_edges)
+        {
+            ++m_firstSucc[e.first + 1];
+            ++m_indegree[e.second];
+        }
+        for (std::size_t i = 0; i < n; ++i)
+            m_firstSucc[i + 1] += m_firstSucc[i];
+        m_succ.resize(m_edges.size());
+        std::vector<std::uint32_t> fill(m_firstSucc.begin(), m_firstSucc.end());
+        for (auto& e : m_edges)
+            m_succ[fill[e.first]++] = e.second;
+
+        // Kahn's algorithm, 'fill' is reused as remaining in-degree.
+        m_order.clear();
+        m_order.reserve(n);
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            fill[i] = m_indegree[i];
+            if (fill[i] == 0)
+                m_order.push_back(static_cast<node_id>(i));
+        }
+        for (std::size_t i = 0; i < m_order.size(); ++i)
+        {
+            auto v = m_order[i];
+            for (auto e = m_firstSucc[v]; e != m_firstSucc[v + 1]; ++e)
+                if (--fill[m_succ[e]] == 0)
+                    m_order.push_back(m_succ[e]);
+        }
+
+        m_pending.reset(new std::atomic<std::uint32_t>[n]);
+        m_runners.resize(n);
+        for (std::size_t i = 0; i < n; ++i)
+            m_runners[i] = Runner{this, static_cast<node_id>(i)};
+        m_times.assign(n, node_time{});
+        m_pathLength.assign(n, 0);
+        m_pathParent.assign(n, noNode);
+        m_compiled = true;
+    }
+
+    std::uint64_t now() const noexcept
+    {
+        return static_cast<std::uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(
+                Clock::now() - m_epoch)
+                .count());
+    }
+
+    void execute(node_id node)
+    {
+        for (;;)
+        {
+            if (m_timing)
+            {
+                m_times[node].start = now();
+                m_tasks[node]();
+                m_times[node].end = now();
+            }
+            else
+                m_tasks[node]();
+
+            // Continue with the first ready successor on this thread.
+            node_id next = noNode;
+            for (auto e = m_firstSucc[node]; e != m_firstSucc[node + 1]; ++e)
+            {
+                node_id s = m_succ[e];
+                if (m_pending[s].fetch_sub(1, std::memory_order_acq_rel) != 1)
+                    continue;
+                if (next == noNode)
+                    next = s;
+                else if (!m_pool->try_submit(Task::make(m_runners[s])))
+                    execute(s);
+            }
+            // Last access to the graph if there is no successor to run.
+            m_done->count_down();
+            if (next == noNode)
+                return;
+            node = next;
+        }
+    }
+
+    std::vector<Task> m_tasks;
+    std::vector<std::pair<node_id, node_id>> m_edges;
+    bool m_compiled = false;
+    bool m_timing = false;
+
+    std::vector<std::uint32_t> m_firstSucc;
+    std::vector<node_id> m_succ;
+    std::vector<std::uint32_t> m_indegree;
+    std::vector<node_id> m_order;
+    std::unique_ptr<std::atomic<std::uint32_t>[]> m_pending;
+    std::vector<Runner> m_runners;
+
+    std::vector<node_time> m_times;
+    std::vector<std::uint64_t> m_pathLength;
+    std::vector<node_id> m_pathParent;
+
+    thread_pool* m_pool = nullptr;
+    delegate_latch* m_done = nullptr;
+    Clock::time_point m_epoch;
+};
+
+#endif /* DELEGATE_TASK_GRAPH_HPP_ */
@@ -0,0 +1,182 @@
+/*
+ * thread_pool.hpp
+ *
+ *  Created on: 18 oct. 2026
+ */
+
+#ifndef DELEGATE_THREAD_POOL_HPP_
+#define DELEGATE_THREAD_POOL_HPP_
+
+#include "delegate/delegate.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * Worker threads executing delegate<void()> tasks.
+ *
+ * Tasks are stored in a fixed capacity ring buffer allocated when the pool
+ * is created. Submitting a task never allocate. 'try_submit' return false
+ * when the queue is full, the caller then typically run the task itself.
+ *
+ * As for any delegate the objects refered to by a task must stay alive until
+ * the task has run. Use a 'delegate_latch' to wait for a group of tasks.
+ *
+ *   thread_pool pool{4};
+ *   delegate_latch done{1};
+ *   Job job{&done};  // operator() run the work, then done.count_down().
+ *   if (!pool.try_submit(delegate<void()>::make(job)))
+ *       job();
+ *   pool.wait(done);
+ */
+
+#if __cplusplus < 201703L
+#error "Require at least C++17 to compile thread_pool"
+#endif
+
+/**
+ * Count down latch. Intended to live on the stack of the waiting thread.
+ * After the final count_down the latch is not touched by the counting
+ * thread, so the waiter may destroy it as soon as 'wait' return.
+ */
+class delegate_latch
+{
+  public:
+    explicit delegate_latch(std::ptrdiff_t count) noexcept : m_count(count) {}
+
+    delegate_latch(const delegate_latch&) = delete;
+    delegate_latch& operator=(const delegate_latch&) = delete;
+
+    void count_down(std::ptrdiff_t n = 1) noexcept
+    {
+        m_count.fetch_sub(n, std::memory_order_release);
+    }
+
+    bool try_wait() const noexcept
+    {
+        return m_count.load(std::memory_order_acquire) == 0;
+    }
+
+    void wait() const noexcept
+    {
+        while (!try_wait())
+            std::this_thread::yield();
+    }
+
+  private:
+    std::atomic<std::ptrdiff_t> m_count;
+};
+
+class thread_pool
+{
+  public:
+    using Task = delegate<void()>;
+
+    explicit thread_pool(std::size_t threads,
+                         std::size_t queueCapacity = 1024)
+        : m_queue(queueCapacity)
+    {
+        m_threads.reserve(threads);
+        for (std::size_t i = 0; i < threads; ++i)
+            m_threads.emplace_back([this] { workerLoop(); });
+    }
+
+    thread_pool(const thread_pool&) = delete;
+    thread_pool& operator=(const thread_pool&) = delete;
+
+    // Already queued tasks are run before the workers exit.
+    ~thread_pool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stop = true;
+        }
+        m_cv.notify_all();
+        for (auto& t : m_threads)
+            t.join();
+    }
+
+    // Queue a task. Return false if the queue is full.
+    bool try_submit(Task task) noexcept
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (m_count == m_queue.size())
+                return false;
+            m_queue[(m_head + m_count) % m_queue.size()] = task;
+            ++m_count;
+        }
+        m_cv.notify_one();
+        return true;
+    }
+
+    // Run one queued task on the calling thread. Return false if none.
+    bool try_run_one()
+    {
+        Task task;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (m_count == 0)
+                return false;
+            task = pop();
+        }
+        task();
+        return true;
+    }
+
+    /**
+     * Wait for 'l' while helping with queued tasks. Safe to call from a
+     * worker thread, e.g. for nested parallel work.
+     */
+    void wait(const delegate_latch& l)
+    {
+        while (!l.try_wait())
+            if (!try_run_one())
+                std::this_thread::yield();
+    }
+
+    // Number of worker threads.
+    std::size_t size() const noexcept
+    {
+        return m_threads.size();
+    }
+
+  private:
+    Task pop() noexcept
+    {
+        Task task = m_queue[m_head];
+        m_head = (m_head + 1) % m_queue.size();
+        --m_count;
+        return task;
+    }
+
+    void workerLoop()
+    {
+        for (;;)
+        {
+            Task task;
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                m_cv.wait(lock, [this] { return m_stop || m_count != 0; });
+                if (m_count == 0)
+                    return;
+                task = pop();
+            }
+            task();
+        }
+    }
+
+    std::mutex m_mutex;
+    std::condition_variable m_cv;
+    std::vector<Task> m_queue;
+    std::size_t m_head = 0;
+    std::size_t m_count = 0;
+    bool m_stop = false;
+    std::vector<std::thread> m_threads;
+};
+
+#endif /* DELEGATE_THREAD_POOL_HPP_ */
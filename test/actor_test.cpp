@@ -0,0 +1,148 @@
+#include "delegate/actor.hpp"
+
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace
+{
+struct Account
+{
+    void deposit(int amount)
+    {
+        // Detect handlers of the same actor running concurrently.
+        if (inHandler.exchange(true))
+            overlap = true;
+        balance += amount;
+        ++count;
+        inHandler = false;
+    }
+    std::atomic<bool> inHandler{false};
+    bool overlap = false;
+    long balance = 0;
+    int count = 0;
+};
+
+struct Player;
+using Ball = mail<void(int)>;
+
+struct Player
+{
+    void hit(int remaining)
+    {
+        ++hits;
+        if (remaining == 0)
+            done->count_down();
+        else
+            other->tell<&Player::hit>(*ball, remaining - 1);
+    }
+    actor<Player>* other = nullptr;
+    Ball* ball = nullptr;
+    delegate_latch* done = nullptr;
+    int hits = 0;
+};
+
+struct Journal
+{
+    void add(const std::string& line)
+    {
+        lines.push_back(line);
+    }
+    void take(std::string&& line)
+    {
+        lines.push_back(std::move(line));
+    }
+    std::vector<std::string> lines;
+};
+
+template <typename T>
+void
+waitIdle(thread_pool& pool, const actor<T>& a)
+{
+    while (!a.idle())
+        if (!pool.try_run_one())
+            std::this_thread::yield();
+}
+} // namespace
+
+TEST(actor, handlers_are_serialized)
+{
+    thread_pool pool{3};
+    actor<Account> account{pool};
+
+    constexpr int senders = 4;
+    constexpr int perSender = 2000;
+    std::vector<std::thread> threads;
+    for (int s = 0; s < senders; ++s)
+        threads.emplace_back([&] {
+            // One mail per message, none is reused.
+            std::vector<mail<void(int)>> mails(perSender);
+            for (auto& m : mails)
+                account.tell<&Account::deposit>(m, 2);
+            while (!account.idle())
+                std::this_thread::yield();
+        });
+    for (auto& t : threads)
+        t.join();
+
+    waitIdle(pool, account);
+    EXPECT_FALSE(account.get().overlap);
+    EXPECT_EQ(account.get().count, senders * perSender);
+    EXPECT_EQ(account.get().balance, 2L * senders * perSender);
+}
+
+TEST(actor, mail_reposted_from_handler)
+{
+    thread_pool pool{2};
+    actor<Player> ping{pool}, pong{pool};
+    Ball toPing, toPong;
+    delegate_latch done{1};
+    ping.get() = Player{&pong, &toPong, &done};
+    pong.get() = Player{&ping, &toPing, &done};
+
+    ping.tell<&Player::hit>(toPing, 999);
+    pool.wait(done);
+    EXPECT_EQ(ping.get().hits + pong.get().hits, 1000);
+    EXPECT_EQ(ping.get().hits, 500);
+    while (!ping.idle() || !pong.idle())
+        std::this_thread::yield();
+}
+
+TEST(actor, prebound_mail_run_on_caller_when_pool_full)
+{
+    thread_pool pool{0, 1};
+    actor<Account> a{pool}, b{pool};
+    mail<void(int)> m1, m2;
+    m1.set(delegate<void(int)>::make<&Account::deposit>(a.get()), 5);
+    m2.set(delegate<void(int)>::make<&Account::deposit>(b.get()), 7);
+
+    // No worker: the first actor is queued, the second run immediately.
+    a.post(m1);
+    EXPECT_EQ(a.get().balance, 0);
+    b.post(m2);
+    EXPECT_EQ(b.get().balance, 7);
+    EXPECT_TRUE(b.idle());
+
+    waitIdle(pool, a);
+    EXPECT_EQ(a.get().balance, 5);
+}
+
+TEST(actor, reference_parameters_get_a_copy)
+{
+    thread_pool pool{0};
+    actor<Journal> journal{pool};
+    mail<void(const std::string&)> add;
+    mail<void(std::string&&)> take;
+    {
+        // Temporaries gone before the handlers run.
+        journal.tell<&Journal::add>(add, std::string(40, 'a'));
+        std::string line = "moved";
+        journal.tell<&Journal::take>(take, std::move(line));
+    }
+    EXPECT_TRUE(journal.get().lines.empty());
+    waitIdle(pool, journal);
+    EXPECT_EQ(journal.get().lines,
+              (std::vector<std::string>{std::string(40, 'a'), "moved"}));
+}
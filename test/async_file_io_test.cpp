@@ -0,0 +1,186 @@
+#include "delegate/async_file_io.hpp"
+
+#include <string>
+#include <vector>
+
+#include <dirent.h>
+#include <fcntl.h>
+#include <stdlib.h>
+
+#include <gtest/gtest.h>
+
+namespace
+{
+using Completion = async_file_io::Completion;
+
+struct TempFile
+{
+    TempFile()
+    {
+        char path[] = "/tmp/delegate_async_io_XXXXXX";
+        fd = ::mkstemp(path);
+        ::unlink(path);
+    }
+    ~TempFile()
+    {
+        ::close(fd);
+    }
+    int fd;
+};
+
+struct Result
+{
+    void onDone(int res)
+    {
+        results.push_back(res);
+    }
+    std::vector<int> results;
+};
+
+// Read back what was written, from the write completion.
+struct Chain
+{
+    void onWritten(int res)
+    {
+        written = res;
+        io->read(fd, buf, sizeof(buf), 0,
+                 Completion::make<&Chain::onRead>(*this));
+    }
+    void onRead(int res)
+    {
+        read = res;
+    }
+    async_file_io* io;
+    int fd;
+    int written = 0;
+    int read = 0;
+    char buf[16] = {};
+};
+
+// Replace the io_uring file descriptors of this process by /dev/null, so
+// io_uring_enter fails. The rings stay mapped. Return how many.
+int
+breakIoUringFds()
+{
+    int count = 0;
+    DIR* dir = ::opendir("/proc/self/fd");
+    if (!dir)
+        return 0;
+    int null = ::open("/dev/null", O_RDONLY);
+    while (dirent* e = ::readdir(dir))
+    {
+        char link[64] = {};
+        std::string path = std::string("/proc/self/fd/") + e->d_name;
+        if (::readlink(path.c_str(), link, sizeof(link) - 1) > 0 &&
+            std::string(link) == "anon_inode:[io_uring]")
+        {
+            ::dup2(null, std::atoi(e->d_name));
+            ++count;
+        }
+    }
+    ::close(null);
+    ::closedir(dir);
+    return count;
+}
+
+class async_file_io_test : public testing::TestWithParam<bool>
+{
+  protected:
+    thread_pool pool{2};
+};
+} // namespace
+
+TEST_P(async_file_io_test, write_then_read)
+{
+    TempFile file;
+    async_file_io io{pool, 8, GetParam()};
+    if (!GetParam())
+    {
+        EXPECT_EQ(io.get_backend(), async_file_io::backend::threads);
+    }
+
+    std::string data[4] = {"aaaa", "bbbb", "cccc", "dddd"};
+    Result writes;
+    for (int i = 0; i < 4; ++i)
+        ASSERT_TRUE(io.write(file.fd, data[i].data(), 4, i * 4,
+                             Completion::make<&Result::onDone>(writes)));
+    EXPECT_EQ(io.in_flight(), 4u);
+    EXPECT_EQ(io.submit(), 4u);
+    io.drain();
+    EXPECT_EQ(writes.results, (std::vector<int>(4, 4)));
+    EXPECT_EQ(io.in_flight(), 0u);
+
+    char buf[16];
+    Result reads;
+    ASSERT_TRUE(io.read(file.fd, buf, 16, 0,
+                        Completion::make<&Result::onDone>(reads)));
+    EXPECT_EQ(io.wait(), 1u);
+    EXPECT_EQ(reads.results, (std::vector<int>{16}));
+    EXPECT_EQ(std::string(buf, 16), "aaaabbbbccccdddd");
+}
+
+TEST_P(async_file_io_test, capacity_and_errors)
+{
+    TempFile file;
+    async_file_io io{pool, 2, GetParam()};
+    char buf[4];
+    Result res;
+    EXPECT_TRUE(io.read(-1, buf, 4, 0, Completion::make<&Result::onDone>(res)));
+    EXPECT_TRUE(io.read(file.fd, buf, 4, 0,
+                        Completion::make<&Result::onDone>(res)));
+    EXPECT_FALSE(io.read(file.fd, buf, 4, 0,
+                         Completion::make<&Result::onDone>(res)));
+    io.drain();
+    ASSERT_EQ(res.results.size(), 2u);
+    // Order of completion is not specified. Empty file, read return 0.
+    EXPECT_TRUE(res.results[0] == -EBADF || res.results[1] == -EBADF);
+    EXPECT_TRUE(res.results[0] == 0 || res.results[1] == 0);
+}
+
+TEST_P(async_file_io_test, completion_start_new_operation)
+{
+    TempFile file;
+    Chain chain;
+    {
+        async_file_io io{pool, 1, GetParam()};
+        chain.io = &io;
+        chain.fd = file.fd;
+        ASSERT_TRUE(io.write(file.fd, "hello", 5, 0,
+                             Completion::make<&Chain::onWritten>(chain)));
+        io.submit();
+        // The destructor wait for the chained read as well.
+    }
+    EXPECT_EQ(chain.written, 5);
+    EXPECT_EQ(chain.read, 5);
+    EXPECT_EQ(std::string(chain.buf), "hello");
+}
+
+TEST(async_file_io, failed_submission_completes_with_errno)
+{
+    thread_pool pool{1};
+    TempFile file;
+    async_file_io io{pool, 4};
+    if (io.get_backend() != async_file_io::backend::io_uring)
+        GTEST_SKIP() << "io_uring not available";
+    ASSERT_EQ(breakIoUringFds(), 1);
+
+    char buf[4];
+    Result res;
+    for (int i = 0; i < 2; ++i)
+        ASSERT_TRUE(io.read(file.fd, buf, 4, 0,
+                            Completion::make<&Result::onDone>(res)));
+    EXPECT_EQ(io.submit(), 0u);
+    ASSERT_EQ(res.results.size(), 2u);
+    EXPECT_LT(res.results[0], 0);
+    EXPECT_EQ(res.results[0], res.results[1]);
+    EXPECT_EQ(io.in_flight(), 0u);
+
+    // Nothing left in the submission ring, a drain returns.
+    ASSERT_TRUE(io.read(file.fd, buf, 4, 0,
+                        Completion::make<&Result::onDone>(res)));
+    io.drain();
+    EXPECT_EQ(res.results.size(), 3u);
+    EXPECT_EQ(io.in_flight(), 0u);
+}
+
+INSTANTIATE_TEST_SUITE_P(backends, async_file_io_test, testing::Bool());
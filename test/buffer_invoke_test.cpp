@@ -0,0 +1,125 @@
+#include "delegate/buffer_invoke.hpp"
+
+#include <gtest/gtest.h>
+
+namespace
+{
+struct Point
+{
+    float x;
+    float y;
+};
+
+struct Receiver
+{
+    void onMessage(int a, double b, std::uint16_t c)
+    {
+        sumA += a;
+        lastB = b;
+        lastC = c;
+    }
+
+    void onPoint(const Point& p, char tag)
+    {
+        ptr = &p;
+        x = p.x;
+        y = p.y;
+        lastTag = tag;
+    }
+
+    int sumA = 0;
+    double lastB = 0;
+    std::uint16_t lastC = 0;
+    const Point* ptr = nullptr;
+    float x = 0;
+    float y = 0;
+    char lastTag = 0;
+};
+} // namespace
+
+TEST(buffer_invoke, packed_round_trip)
+{
+    using Sig = void(int, double, std::uint16_t);
+    static_assert(encoded_size<Sig>() ==
+                      sizeof(int) + sizeof(double) + sizeof(std::uint16_t),
+                  "Packed layout has no padding");
+
+    std::byte buf[encoded_size<Sig>() + 1];
+    EXPECT_EQ(encode_call<Sig>(buf, sizeof buf, 7, 1.5, 42),
+              encoded_size<Sig>());
+
+    Receiver r;
+    auto del = delegate<Sig>::make<&Receiver::onMessage>(r);
+    EXPECT_TRUE(invoke_from_buffer(del, buf, encoded_size<Sig>()));
+    EXPECT_EQ(r.sumA, 7);
+    EXPECT_EQ(r.lastB, 1.5);
+    EXPECT_EQ(r.lastC, 42);
+
+    // Packed data is read at any alignment.
+    std::byte shifted[sizeof buf + 1];
+    std::memcpy(shifted + 1, buf, sizeof buf);
+    EXPECT_TRUE(invoke_from_buffer(del, shifted + 1, encoded_size<Sig>()));
+    EXPECT_EQ(r.sumA, 14);
+}
+
+TEST(buffer_invoke, too_small_buffers_are_rejected)
+{
+    using Sig = void(int, double, std::uint16_t);
+    std::byte buf[encoded_size<Sig>()];
+    EXPECT_EQ(encode_call<Sig>(buf, sizeof buf - 1, 7, 1.5, 42), 0u);
+
+    Receiver r;
+    auto del = delegate<Sig>::make<&Receiver::onMessage>(r);
+    EXPECT_FALSE(invoke_from_buffer(del, buf, sizeof buf - 1));
+    EXPECT_EQ(r.sumA, 0);
+}
+
+TEST(buffer_invoke, aligned_layout_pass_reference_into_buffer)
+{
+    using Sig = void(const Point&, char);
+    using Layout = aligned_layout;
+    static_assert(encoded_align<Sig, Layout>() == alignof(Point),
+                  "Aligned to largest argument");
+
+    alignas(Point) std::byte buf[encoded_size<Sig, Layout>()];
+    EXPECT_EQ((encode_call<Sig, Layout>(buf, sizeof buf, Point{1, 2}, 'q')),
+              sizeof buf);
+
+    Receiver r;
+    auto del = delegate<Sig>::make<&Receiver::onPoint>(r);
+    EXPECT_TRUE(invoke_from_buffer<Layout>(del, buf, sizeof buf));
+    EXPECT_EQ(static_cast<const void*>(r.ptr), static_cast<void*>(buf));
+    EXPECT_EQ(r.x, 1);
+    EXPECT_EQ(r.y, 2);
+    EXPECT_EQ(r.lastTag, 'q');
+
+    // Packed layout of the same signature copy the argument.
+    std::byte packed[encoded_size<Sig>()];
+    encode_call<Sig>(packed, sizeof packed, Point{3, 4}, 'p');
+    EXPECT_TRUE(invoke_from_buffer(del, packed, sizeof packed));
+    EXPECT_NE(static_cast<const void*>(r.ptr), static_cast<void*>(packed));
+    EXPECT_EQ(r.x, 3);
+    EXPECT_EQ(r.lastTag, 'p');
+}
+
+TEST(buffer_invoke, aligned_layout_reject_misaligned_buffer)
+{
+    using Sig = void(const Point&, char);
+    using Layout = aligned_layout;
+
+    alignas(Point) std::byte buf[encoded_size<Sig, Layout>() + 1];
+    encode_call<Sig, Layout>(buf, sizeof buf, Point{1, 2}, 'q');
+
+    Receiver r;
+    auto del = delegate<Sig>::make<&Receiver::onPoint>(r);
+    EXPECT_FALSE(invoke_from_buffer<Layout>(del, buf + 1, sizeof buf - 1));
+    EXPECT_EQ(r.ptr, nullptr);
+}
+
+TEST(buffer_invoke, null_delegate_and_empty_signature)
+{
+    std::byte buf[1];
+    EXPECT_EQ(encoded_size<void()>(), 0u);
+    EXPECT_EQ(encode_call<void()>(buf, 0), 0u);
+    EXPECT_TRUE(invoke_from_buffer(delegate<void()>{}, buf, 0));
+}
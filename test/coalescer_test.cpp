@@ -0,0 +1,159 @@
+#include "delegate/coalescer.hpp"
+
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace
+{
+struct Widget
+{
+    void redraw()
+    {
+        ++redraws;
+    }
+    void relayout()
+    {
+        ++relayouts;
+    }
+    int redraws = 0;
+    int relayouts = 0;
+};
+
+using Del = delegate<void()>;
+} // namespace
+
+TEST(coalescer, duplicates_run_once_per_flush)
+{
+    coalescer<8> dirty;
+    Widget w1;
+    Widget w2;
+
+    for (int i = 0; i < 100; ++i)
+    {
+        EXPECT_TRUE(dirty.post(Del::make<&Widget::redraw>(w1)));
+        EXPECT_TRUE(dirty.post(Del::make<&Widget::redraw>(w2)));
+        EXPECT_TRUE(dirty.post(Del::make<&Widget::relayout>(w1)));
+    }
+    EXPECT_EQ(dirty.flush(), 3u);
+    EXPECT_EQ(w1.redraws, 1);
+    EXPECT_EQ(w2.redraws, 1);
+    EXPECT_EQ(w1.relayouts, 1);
+
+    // Nothing posted.
+    EXPECT_EQ(dirty.flush(), 0u);
+
+    dirty.post(Del::make<&Widget::redraw>(w1));
+    EXPECT_EQ(dirty.flush(), 1u);
+    EXPECT_EQ(w1.redraws, 2);
+}
+
+TEST(coalescer, run_in_first_post_order)
+{
+    static std::vector<int> order;
+    struct Rec
+    {
+        void operator()()
+        {
+            order.push_back(id);
+        }
+        int id;
+    };
+    Rec a{1}, b{2}, c{3};
+
+    coalescer<4> q;
+    q.post(Del::make(b));
+    q.post(Del::make(a));
+    q.post(Del::make(b));
+    q.post(Del::make(c));
+    q.flush();
+    EXPECT_EQ(order, (std::vector<int>{2, 1, 3}));
+}
+
+TEST(coalescer, full_coalescer_reject_new_delegates)
+{
+    coalescer<2> q;
+    Widget w[3];
+    EXPECT_TRUE(q.post(Del::make<&Widget::redraw>(w[0])));
+    EXPECT_TRUE(q.post(Del::make<&Widget::redraw>(w[1])));
+    EXPECT_FALSE(q.post(Del::make<&Widget::redraw>(w[2])));
+    // Already pending delegates are still accepted.
+    EXPECT_TRUE(q.post(Del::make<&Widget::redraw>(w[1])));
+    EXPECT_EQ(q.dropped(), 1u);
+
+    q.flush();
+    EXPECT_TRUE(q.post(Del::make<&Widget::redraw>(w[2])));
+    q.flush();
+    EXPECT_EQ(w[0].redraws, 1);
+    EXPECT_EQ(w[2].redraws, 1);
+}
+
+TEST(coalescer, post_during_flush_run_next_flush)
+{
+    struct Repost
+    {
+        void operator()()
+        {
+            ++calls;
+            if (calls == 1)
+                q->post(Del::make(*this));
+        }
+        coalescer<4>* q;
+        int calls = 0;
+    };
+    coalescer<4> q;
+    Repost r{&q};
+    q.post(Del::make(r));
+    EXPECT_EQ(q.flush(), 1u);
+    EXPECT_EQ(r.calls, 1);
+    EXPECT_EQ(q.flush(), 1u);
+    EXPECT_EQ(r.calls, 2);
+}
+
+TEST(coalescer, concurrent_producers)
+{
+    constexpr int objects = 32;
+    static std::atomic<int> calls[objects];
+    struct Mark
+    {
+        void operator()()
+        {
+            calls[id]++;
+        }
+        int id;
+    };
+    std::vector<Mark> marks;
+    for (int i = 0; i < objects; ++i)
+        marks.push_back(Mark{i});
+
+    coalescer<objects> q;
+    std::atomic<bool> done{false};
+    std::vector<std::thread> producers;
+    for (int t = 0; t < 4; ++t)
+        producers.emplace_back([&] {
+            for (int n = 0; n < 2000; ++n)
+                q.post(Del::make(marks[n % objects]));
+        });
+
+    std::size_t flushed = 0;
+    std::thread consumer([&] {
+        while (!done)
+            flushed += q.flush();
+    });
+    for (auto& p : producers)
+        p.join();
+    done = true;
+    consumer.join();
+    flushed += q.flush();
+
+    int total = 0;
+    for (auto& c : calls)
+    {
+        EXPECT_GE(c.load(), 1);
+        total += c;
+    }
+    EXPECT_EQ(static_cast<std::size_t>(total), flushed);
+    EXPECT_LE(total, 4 * 2000);
+    EXPECT_EQ(q.dropped(), 0u);
+}
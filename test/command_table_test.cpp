@@ -0,0 +1,87 @@
+#include "delegate/command_table.hpp"
+
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace
+{
+int
+cmdReset(int x)
+{
+    return x + 1;
+}
+
+int
+cmdStats(int x)
+{
+    return x + 2;
+}
+
+int
+cmdQuit(int x)
+{
+    return x + 3;
+}
+
+using Del = delegate<int(int)>;
+
+constexpr auto s_table = make_command_table<int(int)>({
+    {"reset", Del::make<cmdReset>()},
+    {"stats", Del::make<cmdStats>()},
+    {"quit", Del::make<cmdQuit>()},
+});
+static_assert(s_table.ok(), "Valid table");
+static_assert(s_table.contains("stats"), "Lookup at compile time");
+static_assert(!s_table.contains("stat"), "Lookup at compile time");
+} // namespace
+
+TEST(command_table, find_dispatch_to_delegate)
+{
+    EXPECT_EQ(s_table.size(), 3u);
+    EXPECT_EQ(s_table.find("reset")(10), 11);
+    EXPECT_EQ(s_table.find("stats")(10), 12);
+    EXPECT_EQ(s_table.find("quit")(10), 13);
+    EXPECT_EQ(s_table.find("reset"), Del::make<cmdReset>());
+}
+
+TEST(command_table, unknown_name_gives_null_delegate)
+{
+    EXPECT_TRUE(s_table.find("").null());
+    EXPECT_TRUE(s_table.find("resets").null());
+    EXPECT_TRUE(s_table.find("Reset").null());
+    EXPECT_EQ(s_table.find("nope")(10), 0);
+}
+
+TEST(command_table, duplicate_names_are_rejected)
+{
+    constexpr auto table = make_command_table<int(int)>({
+        {"reset", Del::make<cmdReset>()},
+        {"reset", Del::make<cmdStats>()},
+    });
+    static_assert(!table.ok(), "Duplicate detected");
+}
+
+TEST(command_table, many_entries_are_all_found)
+{
+    constexpr std::size_t count = 300;
+    std::vector<std::string> names;
+    for (std::size_t i = 0; i < count; ++i)
+        names.push_back("command_" + std::to_string(i * 7919));
+
+    std::array<command_entry<int(int)>, count> entries{};
+    for (std::size_t i = 0; i < count; ++i)
+        entries[i] = {names[i], Del::make<cmdStats>()};
+
+    auto table = make_command_table(entries);
+    ASSERT_TRUE(table.ok());
+    for (const auto& name : names)
+        EXPECT_TRUE(table.contains(name)) << name;
+    EXPECT_FALSE(table.contains("command_1"));
+
+    std::size_t n = 0;
+    for (const auto& entry : table)
+        n += entry.del.null() ? 0 : 1;
+    EXPECT_EQ(n, count);
+}
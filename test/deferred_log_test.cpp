@@ -0,0 +1,133 @@
+#include "delegate/deferred_log.hpp"
+
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace
+{
+struct StringSink
+{
+    void write(const char* data, std::size_t size)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        text.append(data, size);
+        ++calls;
+    }
+    std::mutex mutex;
+    std::string text;
+    int calls = 0;
+};
+
+using Sink = log_writer::Sink;
+
+void
+orderLine(log_writer& w, int id, double price, const char* side)
+{
+    w << "order " << id << ' ' << side << " at " << price << '\n';
+}
+
+void
+counterLine(log_writer& w, int thread, unsigned i)
+{
+    w << thread << ':' << i << '\n';
+}
+} // namespace
+
+TEST(log_writer, format_into_sink)
+{
+    StringSink sink;
+    log_writer w{Sink::make<&StringSink::write>(sink), 8};
+    w << "abc" << 42 << '-' << 1.5;
+    EXPECT_EQ(sink.text, "abc42-");
+    w.flush();
+    EXPECT_EQ(sink.text, "abc42-1.5");
+    w << "longer than the buffer";
+    EXPECT_EQ(sink.text, "abc42-1.5longer than the buffer");
+}
+
+TEST(deferred_logger, format_on_background_thread)
+{
+    StringSink sink;
+    {
+        deferred_logger logger{Sink::make<&StringSink::write>(sink)};
+        EXPECT_TRUE(logger.log<&orderLine>(7, 10.25, "buy"));
+        EXPECT_TRUE(logger.log<&orderLine>(8, 3.5, "sell"));
+        logger.flush();
+        EXPECT_EQ(sink.text, "order 7 buy at 10.25\norder 8 sell at 3.5\n");
+        logger.log<&orderLine>(9, 1.0, "buy");
+    }
+    // Destructor write the remaining records.
+    EXPECT_EQ(sink.text, "order 7 buy at 10.25\norder 8 sell at 3.5\n"
+                         "order 9 buy at 1\n");
+}
+
+TEST(deferred_logger, per_thread_order_and_ring_wrap)
+{
+    StringSink sink;
+    constexpr int threads = 3;
+    constexpr unsigned lines = 20000;
+    // Small rings: records wrap around and producers see a full ring.
+    deferred_logger logger{Sink::make<&StringSink::write>(sink), 4, 1000};
+    std::vector<std::thread> producers;
+    for (int t = 0; t < threads; ++t)
+        producers.emplace_back([&, t] {
+            for (unsigned i = 0; i < lines; ++i)
+                while (!logger.log<&counterLine>(t, i))
+                    std::this_thread::yield();
+        });
+    for (auto& p : producers)
+        p.join();
+    logger.flush();
+
+    std::vector<unsigned> next(threads, 0);
+    std::size_t pos = 0;
+    std::size_t count = 0;
+    while (pos < sink.text.size())
+    {
+        auto eol = sink.text.find('\n', pos);
+        auto line = sink.text.substr(pos, eol - pos);
+        auto colon = line.find(':');
+        int t = std::stoi(line.substr(0, colon));
+        unsigned i = std::stoul(line.substr(colon + 1));
+        ASSERT_EQ(i, next[t]++);
+        pos = eol + 1;
+        ++count;
+    }
+    EXPECT_EQ(count, threads * lines);
+    EXPECT_GT(logger.dropped(), 0u);
+}
+
+TEST(deferred_logger, drop_when_out_of_rings)
+{
+    StringSink sink;
+    deferred_logger logger{Sink::make<&StringSink::write>(sink), 1};
+    EXPECT_TRUE(logger.log<&counterLine>(0, 0u));
+    std::thread([&] { EXPECT_FALSE(logger.log<&counterLine>(1, 0u)); })
+        .join();
+    EXPECT_EQ(logger.dropped(), 1u);
+    logger.flush();
+    EXPECT_EQ(sink.text, "0:0\n");
+}
+
+TEST(deferred_logger, alternate_loggers_on_one_thread)
+{
+    StringSink first;
+    StringSink second;
+    deferred_logger a{Sink::make<&StringSink::write>(first), 2};
+    deferred_logger b{Sink::make<&StringSink::write>(second), 2};
+    // Each switch misses the cached ring, the thread keeps its ring.
+    for (unsigned i = 0; i < 3; ++i)
+    {
+        EXPECT_TRUE(a.log<&counterLine>(0, i));
+        EXPECT_TRUE(b.log<&counterLine>(1, i));
+    }
+    a.flush();
+    b.flush();
+    EXPECT_EQ(first.text, "0:0\n0:1\n0:2\n");
+    EXPECT_EQ(second.text, "1:0\n1:1\n1:2\n");
+    EXPECT_EQ(a.dropped() + b.dropped(), 0u);
+}
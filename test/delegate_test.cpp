@@ -163,6 +163,10 @@ struct MemberCheck
     {
         return i + 1;
     }
+    int member2(int i)
+    {
+        return i + 3;
+    }
     int cmember(int i) const
     {
         return i + 2;
@@ -337,6 +341,33 @@ TEST(delegate, Member_short_const_variants_make)
     //     MemberCheck{}); del =
     //     delegate<int(int)>::make<&MemberCheck::cmember>(const MemberCheck{});
 }
+
+// The short form must give the same trampoline as the long form, also with
+// DELEGATE_LEAN where it is deduced differently.
+TEST(delegate, Member_short_equals_long_form)
+{
+    using Del = delegate<int(int)>;
+    MemberCheck mc;
+    const MemberCheck cmc;
+
+    EXPECT_EQ(Del::make<&MemberCheck::member>(mc),
+              (Del::make<MemberCheck, &MemberCheck::member>(mc)));
+    EXPECT_NE(Del::make<&MemberCheck::member>(mc),
+              Del::make<&MemberCheck::member2>(mc));
+    EXPECT_EQ(Del::make<&MemberCheck::cmember>(cmc),
+              (Del::make<MemberCheck, &MemberCheck::cmember>(cmc)));
+
+    Del del;
+    del.set<&MemberCheck::cmember>(mc);
+    EXPECT_EQ(del, (Del::make<MemberCheck, &MemberCheck::cmember>(mc)));
+    EXPECT_EQ(del(1), 3);
+
+    EXPECT_EQ(Del::make(Del::memFkn<&MemberCheck::cmember>(), cmc),
+              Del::make(Del::memFkn<MemberCheck, &MemberCheck::cmember>(),
+                        cmc));
+    EXPECT_EQ(Del::make(Del::memFkn<&MemberCheck::member>(), mc),
+              Del::make<&MemberCheck::member>(mc));
+}
 #endif
 
 // Make sure we can store member function pointer with correct const
@@ -760,6 +791,165 @@ TEST(delegate, can_store_in_a_set)
     EXPECT_EQ(testSet.size(), 2);
 }
 
+#include <unordered_set>
+
+TEST(delegate, can_store_in_an_unordered_set)
+{
+    using Del = delegate<int(int)>;
+    MemberCheck mc;
+    MemberCheck mc2;
+
+    std::unordered_set<Del, Del::Hash, Del::Equal> testSet;
+    testSet.insert(Del::make<freeFkn>());
+    testSet.insert(Del::make<freeFkn2>());
+    testSet.insert(Del::make<freeFkn>());
+    testSet.insert(Del::make(freeFkn));
+    testSet.insert(Del::make<MemberCheck, &MemberCheck::member>(mc));
+    testSet.insert(Del::make<MemberCheck, &MemberCheck::member>(mc2));
+    testSet.insert(Del::make<MemberCheck, &MemberCheck::member>(mc));
+#ifdef DELEGATE_FOLD_TRAMPOLINES
+    // make<freeFkn>() and make(freeFkn) are the same delegate.
+    EXPECT_EQ(testSet.size(), 4);
+#else
+    EXPECT_EQ(testSet.size(), 5);
+#endif
+
+    EXPECT_EQ(Del::hash(Del::make(freeFkn)), Del::hash(Del::make(freeFkn)));
+    EXPECT_EQ(Del::hash(Del{}), Del::hash(Del{}));
+}
+
+TEST(delegate, less_is_a_strict_order_with_null_first)
+{
+    using Del = delegate<int(int)>;
+    MemberCheck mc;
+    Del dels[] = {Del::make<freeFkn>(), Del::make<freeFkn2>(),
+                  Del::make(freeFkn),
+                  Del::make<MemberCheck, &MemberCheck::member>(mc)};
+
+    for (auto& d : dels)
+    {
+        EXPECT_TRUE(Del::less(Del{}, d));
+        EXPECT_FALSE(Del::less(d, Del{}));
+        EXPECT_FALSE(Del::less(d, d));
+        for (auto& other : dels)
+            EXPECT_FALSE(Del::less(d, other) && Del::less(other, d));
+    }
+    EXPECT_FALSE(Del::less(Del{}, Del{}));
+}
+
+TEST(delegate, MemFkn_less_is_a_strict_order_with_null_first)
+{
+    using Del = delegate<int(int)>;
+    using MF = MemFkn<Del, false>;
+    MF fkns[] = {Del::memFkn<MemberCheck, &MemberCheck::member>(),
+                 Del::memFkn<MemberCheck, &MemberCheck::member2>()};
+
+    for (auto& f : fkns)
+    {
+        EXPECT_TRUE(MF::less(MF{}, f));
+        EXPECT_FALSE(MF::less(f, MF{}));
+        EXPECT_FALSE(MF::less(f, f));
+        for (auto& other : fkns)
+            EXPECT_FALSE(MF::less(f, other) && MF::less(other, f));
+    }
+    EXPECT_FALSE(MF::less(MF{}, MF{}));
+    EXPECT_NE(MF::less(fkns[0], fkns[1]), MF::less(fkns[1], fkns[0]));
+}
+
+TEST(delegate, equal_for_same_target)
+{
+    using Del = delegate<int(int)>;
+    MemberCheck mc;
+
+    EXPECT_TRUE(Del::make<freeFkn>().equal(Del::make<freeFkn>()));
+    EXPECT_FALSE(Del::make<freeFkn>().equal(Del::make<freeFkn2>()));
+    EXPECT_FALSE(Del::make<freeFkn>().equal(Del{}));
+    EXPECT_FALSE(Del::make<freeFkn>().null());
+    EXPECT_TRUE(Del::make<nullptr>().null());
+    EXPECT_FALSE(Del::make<freeFkn>().equal(
+        Del::make<MemberCheck, &MemberCheck::member>(mc)));
+    EXPECT_EQ(Del::make<freeFkn>()(1), freeFkn(1));
+    EXPECT_EQ(Del{}.set<freeFkn2>()(1), freeFkn2(1));
+
+    auto l1 = [](int x) { return x + 10; };
+    auto l2 = [](int x) { return x + 20; };
+    EXPECT_EQ(Del::make(l1)(1), 11);
+    EXPECT_EQ(Del{}.set(l2)(1), 21);
+    EXPECT_FALSE(Del::make(l1).equal(Del::make(l2)));
+    EXPECT_TRUE(Del::make(l1).equal(Del::make(l1)));
+}
+
+TEST(delegate, rebase_moves_context_in_range)
+{
+    using Del = delegate<int(int)>;
+    MemberCheck from[2];
+    MemberCheck to[2];
+
+    auto member = Del::make<MemberCheck, &MemberCheck::member>(from[1]);
+    auto free = Del::make<freeFkn>();
+    auto runtime = Del::make(freeFkn);
+    EXPECT_EQ(member.context(), &from[1]);
+    EXPECT_EQ(free.context(), nullptr);
+    EXPECT_EQ(runtime.context(), nullptr);
+
+    EXPECT_TRUE(member.rebase(from, to, sizeof(from)));
+    EXPECT_TRUE(member.equal(
+        Del::make<MemberCheck, &MemberCheck::member>(to[1])));
+    EXPECT_EQ(member(1), 2);
+
+    // Outside of the range, or no object.
+    EXPECT_FALSE(member.rebase(from, to, sizeof(from)));
+    EXPECT_FALSE(member.rebase(&to[0], &from[0], sizeof(MemberCheck)));
+    EXPECT_FALSE(free.rebase(nullptr, to, sizeof(from)));
+    EXPECT_FALSE(runtime.rebase(nullptr, to, static_cast<std::size_t>(-1)));
+    EXPECT_TRUE(runtime.equal(Del::make(freeFkn)));
+}
+
+#include <string>
+#include <utility>
+
+static std::size_t
+takeString(std::string&& s)
+{
+    std::string taken = std::move(s);
+    return taken.size();
+}
+
+TEST(delegate, forwards_rvalue_reference_arguments)
+{
+    using Del = delegate<std::size_t(std::string&&)>;
+    std::string s = "moved";
+    EXPECT_EQ(Del::make<takeString>()(std::move(s)), 5u);
+    EXPECT_TRUE(s.empty());
+
+    s = "again";
+    EXPECT_EQ(Del::make(takeString)(std::move(s)), 5u);
+    EXPECT_TRUE(s.empty());
+}
+
+struct IncrementRef
+{
+    int operator()(int& x) const
+    {
+        return ++x;
+    }
+};
+
+// By-value parameters are passed on as lvalues, targets may take them by
+// non-const reference.
+TEST(delegate, by_value_arguments_bind_to_lvalue_references)
+{
+    auto l = [](int& x) { return ++x; };
+    EXPECT_EQ(delegate<int(int)>::make(l)(1), 2);
+
+    const IncrementRef inc{};
+    EXPECT_EQ(delegate<int(int)>::make(inc)(4), 5);
+    EXPECT_EQ(delegate_ref<int(int)>(l)(6), 7);
+    static_assert(std::is_constructible<delegate_ref<int(int)>,
+                                        IncrementRef&>::value,
+                  "Callable with an lvalue int");
+}
+
 static int
 testAdd(int x, int y)
 {
@@ -796,6 +986,12 @@ adder(TestObj& o, int val)
     return o.m_val + val;
 }
 
+int
+adderc(const TestObj& o, int val)
+{
+    return o.m_val + val;
+}
+
 void
 testFreeFunctionWithPtr()
 {
@@ -817,3 +1013,179 @@ TEST(oldtests, testrun)
 {
     testFreeFunctionWithPtr();
 }
+
+TEST(delegate, free_function_with_const_object_ref)
+{
+    TestObj o{3};
+    auto cb = delegate<int(int)>::make<TestObj, adderc>(o);
+    EXPECT_EQ(cb(1), 4);
+    o.m_val = 5;
+    EXPECT_EQ(cb(1), 6);
+}
+
+static int
+sumOver(delegate_ref<int(int)> cb, int n)
+{
+    int sum = 0;
+    for (int i = 0; i < n; ++i)
+        sum += cb(i);
+    return sum;
+}
+
+TEST(delegate_ref, bind_to_temporaries_for_the_call)
+{
+    int offset = 10;
+    EXPECT_EQ(sumOver([&](int i) { return i + offset; }, 3), 33);
+
+    struct Scale
+    {
+        int operator()(int i) const
+        {
+            return i * factor;
+        }
+        int factor;
+    };
+    EXPECT_EQ(sumOver(Scale{2}, 4), 12);
+
+    const Scale three{3};
+    EXPECT_EQ(sumOver(three, 3), 9);
+}
+
+TEST(delegate_ref, from_delegate_and_function_pointer)
+{
+    using Del = delegate<int(int)>;
+    EXPECT_EQ(sumOver(Del::make<freeFkn>(), 2), 11);
+    EXPECT_EQ(sumOver(freeFkn, 2), 11);
+    EXPECT_EQ(sumOver(&freeFkn2, 1), 6);
+
+    delegate_ref<int(int)> null = Del{};
+    EXPECT_TRUE(null.null());
+    EXPECT_EQ(null(4), 0);
+    EXPECT_TRUE(static_cast<bool>(delegate_ref<int(int)>(freeFkn)));
+}
+
+static int
+takeRef(delegate_ref<void(int)> cb)
+{
+    cb(1);
+    return 1;
+}
+
+static int
+takeRef(delegate_ref<void(std::string)> cb)
+{
+    cb("ab");
+    return 2;
+}
+
+TEST(delegate_ref, null_from_nullptr)
+{
+    delegate_ref<int(int)> null = nullptr;
+    EXPECT_TRUE(null.null());
+    EXPECT_EQ(null(4), 0);
+    EXPECT_EQ(sumOver(nullptr, 3), 0);
+}
+
+TEST(delegate_ref, overload_selected_by_signature)
+{
+    int calls = 0;
+    EXPECT_EQ(takeRef([&](int) { ++calls; }), 1);
+    EXPECT_EQ(takeRef([&](std::string) { ++calls; }), 2);
+    EXPECT_EQ(calls, 2);
+
+    auto intResult = [](int i) { return i; };
+    static_assert(std::is_constructible<delegate_ref<long(int)>,
+                                        decltype(intResult)>::value,
+                  "Result converts to long");
+    auto wrongResult = [](int) { return "text"; };
+    static_assert(!std::is_constructible<delegate_ref<int(int)>,
+                                         decltype(wrongResult)>::value,
+                  "Result does not convert to int");
+}
+
+TEST(delegate_ref, two_words_and_trivially_copyable)
+{
+    using Ref = delegate_ref<void(int)>;
+    EXPECT_EQ(sizeof(Ref), 2 * sizeof(void*));
+    EXPECT_TRUE(std::is_trivially_copyable<Ref>::value);
+}
+
+namespace
+{
+struct NoDefault
+{
+    explicit NoDefault(int v) : value(v) {}
+    int value;
+};
+
+NoDefault
+makeNoDefault(int v)
+{
+    return NoDefault{v};
+}
+
+enum class Color
+{
+    red,
+    magenta
+};
+
+Color
+red()
+{
+    return Color::red;
+}
+} // namespace
+
+template <>
+struct delegate_null_policy<Color()>
+{
+    static Color on_null()
+    {
+        return Color::magenta;
+    }
+};
+
+template <>
+struct delegate_null_policy<long(long)> : delegate_null_trap<long(long)>
+{
+};
+
+TEST(delegate, try_call_into)
+{
+    delegate<NoDefault(int)> del;
+    NoDefault out{1};
+    EXPECT_FALSE(del.try_call_into(out, 5));
+    EXPECT_EQ(out.value, 1);
+
+    del = delegate<NoDefault(int)>::make<makeNoDefault>();
+    EXPECT_TRUE(del.try_call_into(out, 5));
+    EXPECT_EQ(out.value, 5);
+}
+
+#if __cplusplus >= 201703L
+TEST(delegate, try_call_return_optional)
+{
+    delegate<NoDefault(int)> del;
+    EXPECT_FALSE(del.try_call(3).has_value());
+    del = delegate<NoDefault(int)>::make<makeNoDefault>();
+    EXPECT_EQ(del.try_call(3)->value, 3);
+
+    delegate<void(int)> vdel;
+    EXPECT_FALSE(vdel.try_call(1));
+    vdel = delegate<void(int)>::make<testFkn12>();
+    EXPECT_TRUE(vdel.try_call(1));
+    EXPECT_EQ(s_obj, 2);
+}
+#endif
+
+TEST(delegate, null_policy)
+{
+    delegate<Color()> del;
+    EXPECT_EQ(del(), Color::magenta);
+    del = delegate<Color()>::make<red>();
+    EXPECT_EQ(del(), Color::red);
+
+    delegate<long(long)> trap;
+    EXPECT_DEATH(trap(1), "");
+}
@@ -0,0 +1,141 @@
+#include "delegate/event_bus.hpp"
+
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace
+{
+struct KeyPressed
+{
+    char key;
+};
+
+struct MouseMoved
+{
+    int x;
+    int y;
+};
+
+struct Message
+{
+    std::string text;
+};
+
+using Events = event_list<KeyPressed, MouseMoved, Message>;
+using Bus = event_bus<Events, 2, 8>;
+
+struct Recorder
+{
+    void onKey(const KeyPressed& e)
+    {
+        log += e.key;
+    }
+    void onMouse(const MouseMoved& e)
+    {
+        sum += e.x + e.y;
+    }
+    void onMessage(const Message& e)
+    {
+        log += e.text;
+    }
+    std::string log;
+    int sum = 0;
+};
+
+static_assert(Bus::event_id<KeyPressed>() == 0);
+static_assert(Bus::event_id<MouseMoved>() == 1);
+static_assert(Bus::event_id<Message>() == 2);
+static_assert(Bus::event_count() == 3);
+} // namespace
+
+TEST(event_bus, subscribe_publish_unsubscribe)
+{
+    Recorder a, b;
+    Bus bus;
+    auto ha = bus.subscribe<KeyPressed>(
+        Bus::Del<KeyPressed>::make<&Recorder::onKey>(a));
+    auto hb = bus.subscribe<KeyPressed>(
+        Bus::Del<KeyPressed>::make<&Recorder::onKey>(b));
+    bus.subscribe<MouseMoved>(
+        Bus::Del<MouseMoved>::make<&Recorder::onMouse>(a));
+    EXPECT_NE(ha, 0u);
+    EXPECT_NE(ha, hb);
+    EXPECT_EQ(bus.subscriber_count<KeyPressed>(), 2u);
+
+    // Full.
+    EXPECT_EQ(bus.subscribe<KeyPressed>(
+                  Bus::Del<KeyPressed>::make<&Recorder::onKey>(a)),
+              0u);
+
+    bus.publish(KeyPressed{'x'});
+    bus.publish(MouseMoved{1, 2});
+    bus.publish(Message{"ignored"});
+    EXPECT_EQ(a.log, "x");
+    EXPECT_EQ(b.log, "x");
+    EXPECT_EQ(a.sum, 3);
+
+    EXPECT_FALSE(bus.unsubscribe<MouseMoved>(ha));
+    EXPECT_TRUE(bus.unsubscribe<KeyPressed>(ha));
+    EXPECT_FALSE(bus.unsubscribe<KeyPressed>(ha));
+    EXPECT_FALSE(bus.unsubscribe<KeyPressed>(0));
+    bus.publish(KeyPressed{'y'});
+    EXPECT_EQ(a.log, "x");
+    EXPECT_EQ(b.log, "xy");
+}
+
+TEST(event_bus, post_and_drain_in_order)
+{
+    Recorder r;
+    Bus bus;
+    bus.subscribe<KeyPressed>(Bus::Del<KeyPressed>::make<&Recorder::onKey>(r));
+    bus.subscribe<Message>(Bus::Del<Message>::make<&Recorder::onMessage>(r));
+
+    EXPECT_TRUE(bus.post(KeyPressed{'a'}));
+    EXPECT_TRUE(bus.post(Message{"bc"}));
+    const KeyPressed d{'d'};
+    EXPECT_TRUE(bus.post(d));
+    EXPECT_EQ(r.log, "");
+
+    EXPECT_EQ(bus.drain(2), 2u);
+    EXPECT_EQ(r.log, "abc");
+    EXPECT_EQ(bus.drain(), 1u);
+    EXPECT_EQ(r.log, "abcd");
+    EXPECT_EQ(bus.drain(), 0u);
+
+    // Queue of 8 entries.
+    for (int i = 0; i < 8; ++i)
+        EXPECT_TRUE(bus.post(KeyPressed{'e'}));
+    EXPECT_FALSE(bus.post(KeyPressed{'f'}));
+    EXPECT_EQ(bus.drain(), 8u);
+    EXPECT_TRUE(bus.post(KeyPressed{'g'}));
+    EXPECT_EQ(bus.drain(), 1u);
+    EXPECT_EQ(r.log, "abcdeeeeeeeeg");
+}
+
+TEST(event_bus, post_from_many_threads)
+{
+    Recorder r;
+    event_bus<Events, 4, 64> bus;
+    bus.subscribe<MouseMoved>(
+        Bus::Del<MouseMoved>::make<&Recorder::onMouse>(r));
+
+    constexpr int threads = 4;
+    constexpr int perThread = 1000;
+    std::vector<std::thread> posters;
+    for (int t = 0; t < threads; ++t)
+        posters.emplace_back([&] {
+            for (int i = 0; i < perThread; ++i)
+                while (!bus.post(MouseMoved{1, 0}))
+                    std::this_thread::yield();
+        });
+
+    int drained = 0;
+    while (drained < threads * perThread)
+        drained += static_cast<int>(bus.drain());
+    for (auto& t : posters)
+        t.join();
+    EXPECT_EQ(r.sum, threads * perThread);
+}
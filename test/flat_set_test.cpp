@@ -0,0 +1,145 @@
+#include "delegate/flat_set.hpp"
+
+#include <algorithm>
+#include <set>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace
+{
+struct Counter
+{
+    void add(int x)
+    {
+        sum += x;
+    }
+    int sum = 0;
+};
+
+using Del = delegate<void(int)>;
+
+std::vector<Del>
+makeDels(std::vector<Counter>& counters)
+{
+    std::vector<Del> dels;
+    for (auto& c : counters)
+        dels.push_back(Del::make<&Counter::add>(c));
+    return dels;
+}
+
+template <typename Set>
+void
+expectSorted(const Set& set)
+{
+    EXPECT_TRUE(std::is_sorted(set.begin(), set.end(), Del::Less{}));
+    EXPECT_EQ(std::adjacent_find(set.begin(), set.end(), Del::Equal{}),
+              set.end());
+}
+} // namespace
+
+TEST(delegate_flat_set, insert_find_erase)
+{
+    std::vector<Counter> counters(8);
+    auto dels = makeDels(counters);
+
+    delegate_flat_set<void(int)> set;
+    EXPECT_TRUE(set.empty());
+    for (auto& d : dels)
+        EXPECT_TRUE(set.insert(d));
+    EXPECT_FALSE(set.insert(dels[3]));
+    EXPECT_EQ(set.size(), 8u);
+    expectSorted(set);
+
+    for (auto& d : dels)
+    {
+        EXPECT_TRUE(set.contains(d));
+        EXPECT_TRUE(set.find(d)->equal(d));
+    }
+    Counter other;
+    EXPECT_FALSE(set.contains(Del::make<&Counter::add>(other)));
+    EXPECT_FALSE(set.contains(Del{}));
+
+    EXPECT_TRUE(set.erase(dels[2]));
+    EXPECT_FALSE(set.erase(dels[2]));
+    EXPECT_EQ(set.find(dels[2]), set.end());
+    EXPECT_EQ(set.count(dels[2]), 0u);
+    EXPECT_EQ(set.size(), 7u);
+    expectSorted(set);
+
+    for (auto& d : set)
+        d(1);
+    for (std::size_t i = 0; i < counters.size(); ++i)
+        EXPECT_EQ(counters[i].sum, i == 2 ? 0 : 1);
+}
+
+TEST(delegate_flat_set, insert_range_merges_and_removes_duplicates)
+{
+    std::vector<Counter> counters(64);
+    auto dels = makeDels(counters);
+
+    delegate_flat_set<void(int)> set;
+    std::set<Del, Del::Less> ref;
+    for (std::size_t i = 0; i < dels.size(); i += 3)
+    {
+        set.insert(dels[i]);
+        ref.insert(dels[i]);
+    }
+
+    // Reversed, with duplicates of new and existing elements.
+    std::vector<Del> more(dels.rbegin(), dels.rend());
+    more.insert(more.end(), dels.begin(), dels.begin() + 10);
+    auto added = set.insert_range(more.begin(), more.end());
+    ref.insert(more.begin(), more.end());
+
+    EXPECT_EQ(added, 64u - 22u);
+    ASSERT_EQ(set.size(), ref.size());
+    EXPECT_TRUE(std::equal(set.begin(), set.end(), ref.begin(), Del::Equal{}));
+}
+
+TEST(delegate_flat_set, static_storage_is_bounded)
+{
+    std::vector<Counter> counters(6);
+    auto dels = makeDels(counters);
+
+    delegate_flat_set<void(int), flat_set_static<4>> set;
+    EXPECT_EQ(set.max_size(), 4u);
+    EXPECT_EQ(set.insert_range(dels.begin(), dels.begin() + 3), 3u);
+    EXPECT_TRUE(set.insert(dels[3]));
+    EXPECT_FALSE(set.insert(dels[4]));
+    EXPECT_EQ(set.size(), 4u);
+
+    EXPECT_TRUE(set.erase(dels[0]));
+    // Does not fit at once, added one at a time until full.
+    EXPECT_EQ(set.insert_range(dels.begin() + 4, dels.end()), 1u);
+    EXPECT_EQ(set.size(), 4u);
+    expectSorted(set);
+
+    set.clear();
+    EXPECT_TRUE(set.empty());
+}
+
+TEST(delegate_flat_set, static_storage_merges_without_buffer)
+{
+    std::vector<Counter> counters(200);
+    auto dels = makeDels(counters);
+
+    delegate_flat_set<void(int), flat_set_static<256>> set;
+    std::set<Del, Del::Less> ref;
+    for (std::size_t i = 0; i < dels.size(); i += 2)
+    {
+        set.insert(dels[i]);
+        ref.insert(dels[i]);
+    }
+
+    // Interleaved with the existing ones, plus duplicates.
+    std::vector<Del> more;
+    for (std::size_t i = 1; i < dels.size(); i += 2)
+        more.push_back(dels[dels.size() - i]);
+    more.insert(more.end(), dels.begin(), dels.begin() + 20);
+    EXPECT_EQ(set.insert_range(more.begin(), more.end()), 100u);
+    ref.insert(more.begin(), more.end());
+
+    ASSERT_EQ(set.size(), ref.size());
+    EXPECT_TRUE(std::equal(set.begin(), set.end(), ref.begin(), Del::Equal{}));
+}
@@ -0,0 +1,130 @@
+#include "delegate/fsm.hpp"
+
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace
+{
+enum class State
+{
+    Idle,
+    Connecting,
+    Open
+};
+
+enum class Event
+{
+    Connect,
+    Ack,
+    Data,
+    Close
+};
+
+struct Conn
+{
+    void sendSyn(int)
+    {
+        log.push_back("syn");
+    }
+    void onAck(int seq)
+    {
+        log.push_back("ack " + std::to_string(seq));
+    }
+    bool ackValid(int seq) const
+    {
+        return seq == expectedSeq;
+    }
+    void onData(int bytes)
+    {
+        received += bytes;
+    }
+    void onClose(int)
+    {
+        log.push_back("close");
+    }
+
+    std::vector<std::string> log;
+    int expectedSeq = 1;
+    int received = 0;
+};
+
+using ConnFsm =
+    fsm<Conn, void(int),
+        transition<State::Idle, Event::Connect, State::Connecting,
+                   &Conn::sendSyn>,
+        transition<State::Connecting, Event::Ack, State::Open, &Conn::onAck,
+                   &Conn::ackValid>,
+        transition<State::Open, Event::Data, State::Open, &Conn::onData>,
+        transition<State::Open, Event::Close, State::Idle, &Conn::onClose>,
+        transition<State::Connecting, Event::Close, State::Idle>>;
+
+static_assert(ConnFsm::state_count == 3, "Three states");
+static_assert(ConnFsm::event_count == 4, "Four events");
+static_assert(ConnFsm::can_handle(State::Idle, Event::Connect), "");
+static_assert(!ConnFsm::can_handle(State::Idle, Event::Data), "");
+} // namespace
+
+TEST(fsm, transitions_call_actions)
+{
+    Conn conn;
+    ConnFsm machine{conn, State::Idle};
+
+    EXPECT_TRUE(machine.dispatch(Event::Connect, 0));
+    EXPECT_EQ(machine.state(), State::Connecting);
+    EXPECT_TRUE(machine.dispatch(Event::Ack, 1));
+    EXPECT_EQ(machine.state(), State::Open);
+    EXPECT_TRUE(machine.dispatch(Event::Data, 100));
+    EXPECT_TRUE(machine.dispatch(Event::Data, 20));
+    EXPECT_EQ(machine.state(), State::Open);
+    EXPECT_TRUE(machine.dispatch(Event::Close, 0));
+    EXPECT_EQ(machine.state(), State::Idle);
+
+    EXPECT_EQ(conn.received, 120);
+    EXPECT_EQ(conn.log,
+              (std::vector<std::string>{"syn", "ack 1", "close"}));
+}
+
+TEST(fsm, guard_and_unhandled_events)
+{
+    Conn conn;
+    ConnFsm machine{conn, State::Idle};
+
+    // No transition for Data in Idle.
+    EXPECT_FALSE(machine.dispatch(Event::Data, 5));
+    EXPECT_EQ(machine.state(), State::Idle);
+    EXPECT_EQ(conn.received, 0);
+
+    machine.dispatch(Event::Connect, 0);
+    // Rejected by the guard, state and action unchanged.
+    EXPECT_FALSE(machine.dispatch(Event::Ack, 7));
+    EXPECT_EQ(machine.state(), State::Connecting);
+    EXPECT_EQ(conn.log.size(), 1u);
+
+    // Transition without action.
+    EXPECT_TRUE(machine.dispatch(Event::Close, 0));
+    EXPECT_EQ(machine.state(), State::Idle);
+    EXPECT_EQ(conn.log.size(), 1u);
+
+    machine.reset(State::Open);
+    EXPECT_TRUE(machine.dispatch(Event::Data, 3));
+    EXPECT_EQ(conn.received, 3);
+    EXPECT_FALSE(machine.dispatch(static_cast<Event>(9), 0));
+}
+
+TEST(fsm, states_outside_table_handle_nothing)
+{
+    Conn conn;
+    // States no transition uses, as initial state or after a reset.
+    ConnFsm machine{conn, static_cast<State>(3)};
+    EXPECT_FALSE(machine.dispatch(Event::Connect, 0));
+    EXPECT_EQ(machine.state(), static_cast<State>(3));
+
+    machine.reset(static_cast<State>(99));
+    for (auto e : {Event::Connect, Event::Ack, Event::Data, Event::Close})
+        EXPECT_FALSE(machine.dispatch(e, 1));
+    EXPECT_EQ(machine.state(), static_cast<State>(99));
+    EXPECT_TRUE(conn.log.empty());
+    EXPECT_EQ(conn.received, 0);
+}
@@ -0,0 +1,118 @@
+#include "delegate/future.hpp"
+
+#include <memory>
+#include <string>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+namespace
+{
+struct Sink
+{
+    void onInt(int&& v)
+    {
+        value = v;
+        ++calls;
+    }
+    void onText(std::string&& s)
+    {
+        text = std::move(s);
+        ++calls;
+    }
+    int value = 0;
+    std::string text;
+    int calls = 0;
+};
+
+std::string
+toText(int&& v)
+{
+    return std::to_string(v);
+}
+
+int
+length(std::string&& s)
+{
+    return static_cast<int>(s.size());
+}
+} // namespace
+
+TEST(future, continuation_before_or_after_value)
+{
+    Sink sink;
+    future_state<int> state;
+    promise<int> p{state};
+    auto f = p.get_future();
+    EXPECT_FALSE(f.ready());
+
+    f.then(delegate<void(int&&)>::make<&Sink::onInt>(sink));
+    EXPECT_EQ(sink.calls, 0);
+    p.set_value(7);
+    EXPECT_TRUE(state.ready());
+    EXPECT_EQ(sink.value, 7);
+    EXPECT_EQ(sink.calls, 1);
+
+    // Reuse, value first.
+    state.reset();
+    EXPECT_FALSE(f.ready());
+    p.set_value(8);
+    EXPECT_TRUE(f.ready());
+    EXPECT_EQ(f.get(), 8);
+    f.then(delegate<void(int&&)>::make<&Sink::onInt>(sink));
+    EXPECT_EQ(sink.value, 8);
+    EXPECT_EQ(sink.calls, 2);
+}
+
+TEST(future, chain_through_stages)
+{
+    Sink sink;
+    future_state<int> state;
+    promise<int> p{state};
+    then_stage<int, std::string> text{
+        delegate<std::string(int&&)>::make<toText>()};
+    then_stage<std::string, int> size{
+        delegate<int(std::string&&)>::make<length>()};
+
+    p.get_future().then(text).then(size).then(
+        delegate<void(int&&)>::make<&Sink::onInt>(sink));
+    p.set_value(12345);
+    EXPECT_EQ(sink.value, 5);
+
+    // Value already there when chained.
+    future_state<int> done;
+    promise<int> q{done};
+    q.set_value(42);
+    text.reset();
+    auto f = q.get_future().then(text);
+    EXPECT_TRUE(f.ready());
+    EXPECT_EQ(f.get(), "42");
+}
+
+TEST(future, move_only_value)
+{
+    future_state<std::unique_ptr<int>> state;
+    promise<std::unique_ptr<int>> p{state};
+    int seen = 0;
+    auto take = [&seen](std::unique_ptr<int>&& v) { seen = *v; };
+    p.get_future().then(
+        delegate<void(std::unique_ptr<int>&&)>::make(take));
+    p.set_value(std::make_unique<int>(3));
+    EXPECT_EQ(seen, 3);
+}
+
+TEST(future, complete_from_another_thread)
+{
+    for (int i = 0; i < 200; ++i)
+    {
+        Sink sink;
+        future_state<std::string> state;
+        promise<std::string> p{state};
+        std::thread producer([&] { p.set_value("done"); });
+        p.get_future().then(
+            delegate<void(std::string&&)>::make<&Sink::onText>(sink));
+        producer.join();
+        EXPECT_EQ(sink.calls, 1);
+        EXPECT_EQ(sink.text, "done");
+    }
+}
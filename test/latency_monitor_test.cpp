@@ -0,0 +1,119 @@
+#include "delegate/latency_monitor.hpp"
+
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace
+{
+struct Work
+{
+    int run(int x)
+    {
+        if (x > 0)
+            std::this_thread::sleep_for(std::chrono::milliseconds(x));
+        return x * 2;
+    }
+};
+
+using Monitor = latency_monitor<int(int), 8>;
+using Del = Monitor::Del;
+
+struct OverrunLog
+{
+    void onOverrun(const Del& d, std::chrono::nanoseconds t)
+    {
+        dels.push_back(d);
+        times.push_back(t);
+    }
+    std::vector<Del> dels;
+    std::vector<std::chrono::nanoseconds> times;
+};
+} // namespace
+
+TEST(latency_histogram, buckets_are_within_one_sixteenth)
+{
+    for (std::uint64_t v : {0ull, 1ull, 15ull, 16ull, 17ull, 100ull, 1000ull,
+                            123456ull, 987654321ull})
+    {
+        auto i = latency_histogram::index(v);
+        auto upper = latency_histogram::upperBound(i);
+        EXPECT_GE(upper, v);
+        EXPECT_LE(upper - v, v / 16);
+        if (i > 0)
+        {
+            EXPECT_LT(latency_histogram::upperBound(i - 1), v);
+        }
+    }
+    auto huge = latency_histogram::index(~std::uint64_t{0});
+    EXPECT_EQ(huge, latency_histogram::bucketCount - 1);
+}
+
+TEST(latency_histogram, percentiles_and_max)
+{
+    latency_histogram h;
+    EXPECT_EQ(h.percentile(0.5), 0u);
+    for (std::uint64_t v = 1; v <= 1000; ++v)
+        h.record(v * 100);
+    EXPECT_EQ(h.count(), 1000u);
+    EXPECT_EQ(h.max(), 100000u);
+    EXPECT_NEAR(double(h.percentile(0.5)), 50000.0, 50000.0 / 16);
+    EXPECT_NEAR(double(h.percentile(0.99)), 99000.0, 99000.0 / 16);
+    EXPECT_EQ(h.percentile(1.0), 100000u);
+
+    h.reset();
+    EXPECT_EQ(h.count(), 0u);
+    EXPECT_EQ(h.max(), 0u);
+}
+
+TEST(latency_monitor, record_and_report_overruns)
+{
+    Work fast, slow, other;
+    OverrunLog log;
+    Monitor monitor{Monitor::Overrun::make<&OverrunLog::onOverrun>(log)};
+
+    auto fastDel = Del::make<&Work::run>(fast);
+    auto slowDel = Del::make<&Work::run>(slow);
+    EXPECT_TRUE(monitor.track(fastDel, std::chrono::seconds(1)));
+    EXPECT_TRUE(monitor.track(slowDel, std::chrono::milliseconds(1)));
+
+    for (int i = 0; i < 10; ++i)
+        EXPECT_EQ(monitor.call(fastDel, 0), 0);
+    EXPECT_EQ(monitor.call(slowDel, 3), 6);
+    EXPECT_EQ(monitor.call(Del::make<&Work::run>(other), 0), 0);
+
+    auto fs = monitor.stats(fastDel);
+    EXPECT_EQ(fs.count, 10u);
+    EXPECT_EQ(fs.overruns, 0u);
+    EXPECT_LE(fs.p50, fs.p99);
+    EXPECT_LE(fs.p99, fs.max);
+
+    auto ss = monitor.stats(slowDel);
+    EXPECT_EQ(ss.count, 1u);
+    EXPECT_EQ(ss.overruns, 1u);
+    EXPECT_GE(ss.max, 3000000u);
+
+    ASSERT_EQ(log.dels.size(), 1u);
+    EXPECT_TRUE(log.dels[0].equal(slowDel));
+    EXPECT_GE(log.times[0], std::chrono::milliseconds(3));
+
+    EXPECT_EQ(monitor.untracked(), 1u);
+    EXPECT_EQ(monitor.histogram(Del::make<&Work::run>(other)), nullptr);
+    EXPECT_EQ(monitor.stats(Del{}).count, 0u);
+}
+
+TEST(latency_monitor, track_is_bounded_and_updates_deadline)
+{
+    std::vector<Work> work(9);
+    Monitor monitor;
+    for (std::size_t i = 0; i < 8; ++i)
+        EXPECT_TRUE(monitor.track(Del::make<&Work::run>(work[i])));
+    EXPECT_FALSE(monitor.track(Del::make<&Work::run>(work[8])));
+    // Already tracked, only the deadline changes.
+    EXPECT_TRUE(monitor.track(Del::make<&Work::run>(work[0]),
+                              std::chrono::nanoseconds(1)));
+    monitor.call(Del::make<&Work::run>(work[0]), 1);
+    EXPECT_EQ(monitor.stats(Del::make<&Work::run>(work[0])).overruns, 1u);
+}
@@ -0,0 +1,81 @@
+#include "delegate/lazy.hpp"
+
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace
+{
+struct Counter
+{
+    int next()
+    {
+        return ++calls * 10;
+    }
+    std::atomic<int> calls{0};
+};
+
+Counter s_localCounter;
+thread_local local_lazy<int> s_localValue{
+    delegate<int()>::make<&Counter::next>(s_localCounter)};
+} // namespace
+
+TEST(lazy, initialize_once_on_first_access)
+{
+    Counter c;
+    lazy<int> value{delegate<int()>::make<&Counter::next>(c)};
+    EXPECT_FALSE(value.initialized());
+    EXPECT_EQ(c.calls, 0);
+
+    EXPECT_EQ(value.get(), 10);
+    EXPECT_TRUE(value.initialized());
+    EXPECT_EQ(*value, 10);
+    EXPECT_EQ(c.calls, 1);
+}
+
+TEST(lazy, concurrent_access_initialize_exactly_once)
+{
+    Counter c;
+    lazy<int> value{delegate<int()>::make<&Counter::next>(c)};
+
+    std::vector<std::thread> threads;
+    std::atomic<int> sum{0};
+    for (int i = 0; i < 8; ++i)
+        threads.emplace_back([&] { sum += value.get(); });
+    for (auto& t : threads)
+        t.join();
+
+    EXPECT_EQ(c.calls, 1);
+    EXPECT_EQ(sum, 80);
+}
+
+TEST(resettable_lazy, reset_recompute_the_value)
+{
+    Counter c;
+    resettable_lazy<int> value{delegate<int()>::make<&Counter::next>(c)};
+    value.reset(); // Reset of empty value is a no-op.
+    EXPECT_EQ(value.get(), 10);
+    EXPECT_EQ(value.get(), 10);
+
+    value.reset();
+    EXPECT_FALSE(value.initialized());
+    EXPECT_EQ(value.get(), 20);
+    EXPECT_EQ(c.calls, 2);
+}
+
+TEST(local_lazy, one_value_per_thread)
+{
+    int first = s_localValue.get();
+    EXPECT_EQ(s_localValue.get(), first);
+
+    int other = 0;
+    std::thread t([&] { other = s_localValue.get(); });
+    t.join();
+    EXPECT_NE(other, first);
+    EXPECT_EQ(s_localCounter.calls, 2);
+
+    s_localValue.reset();
+    EXPECT_FALSE(s_localValue.initialized());
+    EXPECT_EQ(s_localValue.get(), 30);
+}
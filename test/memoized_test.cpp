@@ -0,0 +1,92 @@
+#include "delegate/memoized.hpp"
+
+#include <string>
+
+#include <gtest/gtest.h>
+
+namespace
+{
+struct Routes
+{
+    int lookup(int net, int mask)
+    {
+        ++calls;
+        return net * 100 + mask;
+    }
+    int calls = 0;
+};
+
+int s_lenCalls = 0;
+
+std::size_t
+length(const std::string& s)
+{
+    ++s_lenCalls;
+    return s.size();
+}
+} // namespace
+
+TEST(memoized, repeated_arguments_hit_the_cache)
+{
+    using Del = delegate<int(int, int)>;
+    Routes routes;
+    memoized<int(int, int), 16> cache{Del::make<&Routes::lookup>(routes)};
+    Del del = cache.get_delegate();
+
+    EXPECT_EQ(del(1, 2), 102);
+    EXPECT_EQ(del(1, 2), 102);
+    EXPECT_EQ(del(2, 1), 201);
+    EXPECT_EQ(del(1, 2), 102);
+
+    EXPECT_EQ(routes.calls, 2);
+    EXPECT_EQ(cache.hits(), 2u);
+    EXPECT_EQ(cache.misses(), 2u);
+
+    cache.clear();
+    EXPECT_EQ(del(1, 2), 102);
+    EXPECT_EQ(routes.calls, 3);
+
+    cache.reset_stats();
+    EXPECT_EQ(cache.hits(), 0u);
+    EXPECT_EQ(cache.misses(), 0u);
+}
+
+TEST(memoized, least_recently_used_is_replaced)
+{
+    using Del = delegate<int(int, int)>;
+    Routes routes;
+    // Single set with two ways.
+    memoized<int(int, int), 2, 2> cache{Del::make<&Routes::lookup>(routes)};
+
+    cache(1, 0);
+    cache(2, 0);
+    cache(1, 0); // 2 is now least recently used.
+    cache(3, 0); // Evict 2.
+    EXPECT_EQ(routes.calls, 3);
+
+    cache(1, 0);
+    EXPECT_EQ(routes.calls, 3);
+    cache(2, 0);
+    EXPECT_EQ(routes.calls, 4);
+}
+
+TEST(memoized, reference_arguments_are_stored_by_value)
+{
+    s_lenCalls = 0;
+    using Del = delegate<std::size_t(const std::string&)>;
+    memoized<std::size_t(const std::string&), 8> cache{Del::make<length>()};
+
+    std::string s = "hello";
+    EXPECT_EQ(cache(s), 5u);
+    s = "hi";
+    EXPECT_EQ(cache(s), 2u);
+    EXPECT_EQ(cache(std::string("hello")), 5u);
+    EXPECT_EQ(s_lenCalls, 2);
+}
+
+TEST(memoized, null_function_return_default)
+{
+    memoized<int(int), 4> cache;
+    EXPECT_EQ(cache(3), 0);
+    EXPECT_EQ(cache.misses(), 1u);
+}
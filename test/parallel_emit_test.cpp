@@ -0,0 +1,140 @@
+#include "delegate/parallel_emit.hpp"
+
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace
+{
+struct Shard
+{
+    void onFrame(const std::vector<int>& frame, int scale)
+    {
+        sum = 0;
+        for (int v : frame)
+            sum += v * scale;
+        thread = std::this_thread::get_id();
+        calls++;
+    }
+    long sum = 0;
+    int calls = 0;
+    std::thread::id thread;
+};
+
+using Del = delegate<void(const std::vector<int>&, int)>;
+
+std::vector<Del>
+connect(std::vector<Shard>& shards)
+{
+    std::vector<Del> dels;
+    for (auto& s : shards)
+        dels.push_back(Del::make<&Shard::onFrame>(s));
+    return dels;
+}
+} // namespace
+
+TEST(delegate_latch, count_down_to_zero)
+{
+    delegate_latch l{2};
+    EXPECT_FALSE(l.try_wait());
+    l.count_down();
+    EXPECT_FALSE(l.try_wait());
+    l.count_down();
+    EXPECT_TRUE(l.try_wait());
+    l.wait();
+}
+
+TEST(thread_pool, run_submitted_tasks)
+{
+    struct Task
+    {
+        void operator()()
+        {
+            ran++;
+            done->count_down();
+        }
+        std::atomic<int> ran{0};
+        delegate_latch* done;
+    };
+
+    thread_pool pool{2, 4};
+    EXPECT_EQ(pool.size(), 2u);
+    delegate_latch done{8};
+    Task task;
+    task.done = &done;
+    for (int i = 0; i < 8; ++i)
+        if (!pool.try_submit(delegate<void()>::make(task)))
+            task();
+    pool.wait(done);
+    EXPECT_EQ(task.ran, 8);
+}
+
+TEST(parallel_emit, all_subscribers_called_once)
+{
+    std::vector<Shard> shards(100);
+    auto dels = connect(shards);
+    std::vector<int> frame{1, 2, 3};
+
+    thread_pool pool{3};
+    emit_parallel(pool, dels.data(), dels.size(), frame, 2);
+    for (auto& s : shards)
+    {
+        EXPECT_EQ(s.calls, 1);
+        EXPECT_EQ(s.sum, 12);
+    }
+}
+
+TEST(parallel_emit, below_threshold_run_on_caller)
+{
+    std::vector<Shard> shards(4);
+    auto dels = connect(shards);
+    std::vector<int> frame{1};
+
+    thread_pool pool{3};
+    emit_parallel(pool, parallel_policy{5}, dels.data(), dels.size(), frame,
+                  1);
+    for (auto& s : shards)
+        EXPECT_EQ(s.thread, std::this_thread::get_id());
+
+    // Sequential emit.
+    emit_sequential(dels.data(), dels.size(), frame, 3);
+    EXPECT_EQ(shards[0].sum, 3);
+}
+
+TEST(parallel_emit, nested_emit_from_worker_does_not_deadlock)
+{
+    struct Inner
+    {
+        void onFrame(const std::vector<int>&, int)
+        {
+            calls++;
+        }
+        std::atomic<int> calls{0};
+    };
+    std::vector<Inner> inner(32);
+    std::vector<Del> innerDels;
+    for (auto& i : inner)
+        innerDels.push_back(Del::make<&Inner::onFrame>(i));
+    std::vector<int> frame{1};
+    thread_pool pool{2, 2};
+
+    struct Outer
+    {
+        void onFrame(const std::vector<int>& f, int scale)
+        {
+            emit_parallel(*pool, parallel_policy{1}, dels->data(),
+                          dels->size(), f, scale);
+        }
+        thread_pool* pool;
+        std::vector<Del>* dels;
+    };
+    std::vector<Outer> outer(4, Outer{&pool, &innerDels});
+    std::vector<Del> outerDels;
+    for (auto& o : outer)
+        outerDels.push_back(Del::make<&Outer::onFrame>(o));
+
+    emit_parallel(pool, parallel_policy{1}, outerDels.data(), outerDels.size(),
+                  frame, 1);
+    for (auto& s : inner)
+        EXPECT_EQ(s.calls, 4);
+}
@@ -0,0 +1,84 @@
+#include "delegate/priority_signal.hpp"
+
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace
+{
+struct Handler
+{
+    bool onEvent(int ev)
+    {
+        log->push_back(id);
+        return ev == consumeOn;
+    }
+    std::vector<int>* log;
+    int id;
+    int consumeOn;
+};
+
+using Sig = bool(int);
+using Del = delegate<Sig>;
+} // namespace
+
+TEST(priority_signal, call_in_priority_then_connect_order)
+{
+    std::vector<int> log;
+    Handler h1{&log, 1, -1}, h2{&log, 2, -1}, h3{&log, 3, -1},
+        h4{&log, 4, -1};
+
+    priority_signal<Sig, 8> sig;
+    sig.connect(Del::make<&Handler::onEvent>(h1), 0);
+    sig.connect(Del::make<&Handler::onEvent>(h2), 10);
+    sig.connect(Del::make<&Handler::onEvent>(h3), 0);
+    sig.connect(Del::make<&Handler::onEvent>(h4), 5);
+    EXPECT_EQ(sig.size(), 4u);
+
+    EXPECT_FALSE(sig.emit(0));
+    EXPECT_EQ(log, (std::vector<int>{2, 4, 1, 3}));
+}
+
+TEST(priority_signal, consumed_event_stop_propagation)
+{
+    std::vector<int> log;
+    Handler h1{&log, 1, 7}, h2{&log, 2, 8}, h3{&log, 3, 7};
+
+    priority_signal<Sig, 8> sig;
+    sig.connect(Del::make<&Handler::onEvent>(h1), 1);
+    sig.connect(Del::make<&Handler::onEvent>(h2), 2);
+    sig.connect(Del::make<&Handler::onEvent>(h3), 0);
+
+    EXPECT_TRUE(sig(7));
+    EXPECT_EQ(log, (std::vector<int>{2, 1}));
+
+    log.clear();
+    EXPECT_TRUE(sig(8));
+    EXPECT_EQ(log, (std::vector<int>{2}));
+}
+
+TEST(priority_signal, disconnect_by_handle_and_delegate)
+{
+    std::vector<int> log;
+    Handler h1{&log, 1, -1}, h2{&log, 2, -1}, h3{&log, 3, -1};
+
+    priority_signal<Sig, 3> sig;
+    auto c1 = sig.connect(Del::make<&Handler::onEvent>(h1));
+    auto c2 = sig.connect(Del::make<&Handler::onEvent>(h2));
+    sig.connect(Del::make<&Handler::onEvent>(h3));
+    EXPECT_NE(c1, 0u);
+    EXPECT_NE(c1, c2);
+
+    // Full.
+    EXPECT_EQ(sig.connect(Del::make<&Handler::onEvent>(h1)), 0u);
+
+    EXPECT_TRUE(sig.disconnect(c2));
+    EXPECT_FALSE(sig.disconnect(c2));
+    EXPECT_TRUE(sig.disconnect(Del::make<&Handler::onEvent>(h3)));
+    sig.emit(0);
+    EXPECT_EQ(log, (std::vector<int>{1}));
+
+    sig.clear();
+    EXPECT_TRUE(sig.empty());
+    EXPECT_FALSE(sig.emit(0));
+}
@@ -0,0 +1,161 @@
+#include "delegate/rcu_registry.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace
+{
+using Registry = rcu_registry<void(int), 8>;
+using Del = Registry::Del;
+
+struct Target
+{
+    void onEvent(int x)
+    {
+        if (!alive.load(std::memory_order_relaxed))
+            violations->fetch_add(1, std::memory_order_relaxed);
+        sum.fetch_add(x, std::memory_order_relaxed);
+        if (!alive.load(std::memory_order_relaxed))
+            violations->fetch_add(1, std::memory_order_relaxed);
+    }
+    std::atomic<bool> alive{true};
+    std::atomic<int> sum{0};
+    std::atomic<int>* violations;
+};
+
+struct Blocking
+{
+    void onEvent(int)
+    {
+        entered.store(true);
+        while (!release.load())
+            std::this_thread::yield();
+    }
+    std::atomic<bool> entered{false};
+    std::atomic<bool> release{false};
+};
+} // namespace
+
+TEST(rcu_registry, add_remove_emit)
+{
+    std::atomic<int> violations{0};
+    Target a, b;
+    a.violations = b.violations = &violations;
+
+    Registry reg;
+    auto reader = reg.make_reader();
+    ASSERT_TRUE(reader.valid());
+
+    auto ha = reg.add(Del::make<&Target::onEvent>(a));
+    auto hb = reg.add(Del::make<&Target::onEvent>(b));
+    EXPECT_NE(ha, 0u);
+    EXPECT_NE(ha, hb);
+    EXPECT_EQ(reg.size(), 2u);
+
+    reg.emit(reader, 3);
+    EXPECT_EQ(a.sum, 3);
+    EXPECT_EQ(b.sum, 3);
+
+    EXPECT_TRUE(reg.remove(ha));
+    EXPECT_FALSE(reg.remove(ha));
+    EXPECT_FALSE(reg.remove(0));
+    reg.emit(reader, 2);
+    EXPECT_EQ(a.sum, 3);
+    EXPECT_EQ(b.sum, 5);
+
+    {
+        auto guard = reg.read(reader);
+        EXPECT_EQ(guard.size(), 1u);
+        // Nested read section of the same reader.
+        reg.emit(reader, 1);
+    }
+    EXPECT_EQ(b.sum, 6);
+}
+
+TEST(rcu_registry, full_registry_and_reader_slots)
+{
+    Registry reg{2};
+    auto r1 = reg.make_reader();
+    auto r2 = reg.make_reader();
+    EXPECT_TRUE(r1.valid());
+    EXPECT_TRUE(r2.valid());
+    {
+        auto r3 = reg.make_reader();
+        EXPECT_FALSE(r3.valid());
+    }
+    {
+        auto moved = std::move(r2);
+        EXPECT_TRUE(moved.valid());
+    }
+    EXPECT_TRUE(reg.make_reader().valid());
+
+    for (std::size_t i = 0; i < Registry::capacity(); ++i)
+        EXPECT_NE(reg.add(Del{}), 0u);
+    EXPECT_EQ(reg.add(Del{}), 0u);
+}
+
+TEST(rcu_registry, remove_wait_for_running_callback)
+{
+    Blocking blocking;
+    Registry reg;
+    auto h = reg.add(Del::make<&Blocking::onEvent>(blocking));
+
+    std::thread dispatcher([&] {
+        auto reader = reg.make_reader();
+        reg.emit(reader, 0);
+    });
+    while (!blocking.entered.load())
+        std::this_thread::yield();
+
+    std::atomic<bool> removed{false};
+    std::thread control([&] {
+        reg.remove(h);
+        removed.store(true);
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    EXPECT_FALSE(removed.load());
+    EXPECT_EQ(reg.size(), 0u);
+
+    blocking.release.store(true);
+    control.join();
+    dispatcher.join();
+    EXPECT_TRUE(removed.load());
+}
+
+TEST(rcu_registry, no_call_after_remove_return)
+{
+    std::atomic<int> violations{0};
+    std::vector<Target> targets(4);
+    for (auto& t : targets)
+        t.violations = &violations;
+
+    Registry reg;
+    std::atomic<bool> stop{false};
+    std::vector<std::thread> readers;
+    for (int i = 0; i < 3; ++i)
+    {
+        readers.emplace_back([&] {
+            auto reader = reg.make_reader();
+            while (!stop.load(std::memory_order_relaxed))
+                reg.emit(reader, 1);
+        });
+    }
+
+    for (int round = 0; round < 200; ++round)
+    {
+        auto& t = targets[static_cast<std::size_t>(round) % targets.size()];
+        t.alive.store(true);
+        auto h = reg.add(Del::make<&Target::onEvent>(t));
+        std::this_thread::yield();
+        ASSERT_TRUE(reg.remove(h));
+        t.alive.store(false);
+    }
+    stop.store(true);
+    for (auto& r : readers)
+        r.join();
+    EXPECT_EQ(violations.load(), 0);
+}
@@ -0,0 +1,103 @@
+#include "delegate/relocation.hpp"
+
+#include <array>
+#include <cstring>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace
+{
+struct Obj
+{
+    int get(int x) const
+    {
+        return value + x;
+    }
+    void set(int x)
+    {
+        value = x;
+    }
+    int value;
+};
+
+int
+twice(int x)
+{
+    return 2 * x;
+}
+
+using Get = delegate<int(int)>;
+using Set = delegate<void(int)>;
+} // namespace
+
+TEST(relocation, compact_pool)
+{
+    Obj oldPool[4] = {{1}, {2}, {3}, {4}};
+    Obj newPool[4] = {};
+
+    std::vector<Get> getters;
+    for (auto& o : oldPool)
+        getters.push_back(Get::make<Obj, &Obj::get>(o));
+    getters.push_back(Get::make<twice>());
+    getters.push_back(Get::make(twice));
+    std::array<Set, 2> setters = {Set::make<Obj, &Obj::set>(oldPool[1]),
+                                  Set::make<Obj, &Obj::set>(oldPool[3])};
+    Obj outside{100};
+    auto single = Get::make<Obj, &Obj::get>(outside);
+
+    relocation_registry registry;
+    auto hg = registry.add(getters);
+    registry.add(setters);
+    registry.add(single);
+    EXPECT_EQ(registry.size(), 3u);
+
+    // Keep objects 1 and 3, packed at the start of the new pool.
+    std::memcpy(&newPool[0], &oldPool[1], sizeof(Obj));
+    std::memcpy(&newPool[1], &oldPool[3], sizeof(Obj));
+    std::memset(oldPool, 0, sizeof(oldPool));
+    relocation moves[] = {{&oldPool[3], &newPool[1], sizeof(Obj)},
+                          {&oldPool[1], &newPool[0], sizeof(Obj)}};
+    EXPECT_EQ(registry.relocate(moves, 2), 4u);
+
+    EXPECT_EQ(getters[1](0), 2);
+    EXPECT_EQ(getters[3](0), 4);
+    EXPECT_EQ(getters[0].context(), &oldPool[0]);
+    EXPECT_EQ(getters[4](3), 6);
+    EXPECT_EQ(getters[5](3), 6);
+    EXPECT_EQ(single(0), 100);
+
+    setters[0](20);
+    setters[1](40);
+    EXPECT_EQ(newPool[0].value, 20);
+    EXPECT_EQ(newPool[1].value, 40);
+
+    // Removed containers are not rebased.
+    EXPECT_TRUE(registry.remove(hg));
+    EXPECT_FALSE(registry.remove(hg));
+    EXPECT_FALSE(registry.remove(0));
+    EXPECT_EQ(registry.relocate({&newPool[0], &oldPool[0], sizeof(Obj)}), 1u);
+    EXPECT_EQ(setters[0].context(), &oldPool[0]);
+    EXPECT_EQ(getters[1].context(), &newPool[0]);
+}
+
+TEST(relocation, functor_moved_in_range)
+{
+    struct Adder
+    {
+        int operator()(int x) const
+        {
+            return x + n;
+        }
+        int n;
+    };
+    Adder from[2] = {{1}, {2}};
+    Adder to[2] = {{10}, {20}};
+    std::vector<Get> dels = {Get::make(from[0]), Get::make(from[1])};
+
+    relocation_registry registry;
+    registry.add(dels);
+    EXPECT_EQ(registry.relocate({from, to, sizeof(from)}), 2u);
+    EXPECT_EQ(dels[0](0), 10);
+    EXPECT_EQ(dels[1](0), 20);
+}
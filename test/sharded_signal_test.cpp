@@ -0,0 +1,113 @@
+#include "delegate/sharded_signal.hpp"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace
+{
+struct Counter
+{
+    void add(int x)
+    {
+        sum.fetch_add(x, std::memory_order_relaxed);
+    }
+    std::atomic<int> sum{0};
+};
+
+using Sig = void(int);
+using Del = delegate<Sig>;
+} // namespace
+
+TEST(sharded_signal, connect_emit_disconnect)
+{
+    Counter a, b;
+    sharded_signal<Sig, 4> sig{4};
+    EXPECT_EQ(sig.shard_count(), 4u);
+
+    auto ha = sig.connect(Del::make<&Counter::add>(a));
+    auto hb = sig.connect(Del::make<&Counter::add>(b));
+    EXPECT_NE(ha, 0u);
+    EXPECT_NE(ha, hb);
+    EXPECT_LT(sig.shard_of(ha), 4u);
+    EXPECT_EQ(sig.size(), 2u);
+
+    sig.emit(2);
+    EXPECT_EQ(a.sum, 2);
+    EXPECT_EQ(b.sum, 2);
+
+    EXPECT_TRUE(sig.disconnect(ha));
+    EXPECT_FALSE(sig.disconnect(ha));
+    EXPECT_FALSE(sig.disconnect(0));
+    EXPECT_FALSE(sig.disconnect(hb + (std::uint64_t{9} << 48)));
+    sig(3);
+    EXPECT_EQ(a.sum, 2);
+    EXPECT_EQ(b.sum, 5);
+}
+
+TEST(sharded_signal, full_shard_spill_to_next)
+{
+    std::vector<Counter> counters(7);
+    sharded_signal<Sig, 2> sig{3};
+    std::vector<sharded_signal<Sig, 2>::handle> handles;
+    for (std::size_t i = 0; i < 6; ++i)
+        handles.push_back(sig.connect(Del::make<&Counter::add>(counters[i])));
+    EXPECT_EQ(sig.connect(Del::make<&Counter::add>(counters[6])), 0u);
+
+    std::size_t perShard[3] = {};
+    for (auto h : handles)
+    {
+        ASSERT_NE(h, 0u);
+        ++perShard[sig.shard_of(h)];
+    }
+    for (auto n : perShard)
+        EXPECT_EQ(n, 2u);
+
+    // Disconnect from the middle, the others are still called.
+    EXPECT_TRUE(sig.disconnect(handles[2]));
+    sig.emit(1);
+    for (std::size_t i = 0; i < 6; ++i)
+        EXPECT_EQ(counters[i].sum, i == 2 ? 0 : 1);
+    EXPECT_NE(sig.connect(Del::make<&Counter::add>(counters[6])), 0u);
+}
+
+TEST(sharded_signal, concurrent_connect_disconnect_and_emit)
+{
+    constexpr int threads = 4;
+    constexpr int rounds = 2000;
+    sharded_signal<Sig, 16> sig{2};
+    Counter permanent;
+    sig.connect(Del::make<&Counter::add>(permanent));
+
+    std::atomic<bool> stop{false};
+    std::thread emitter([&] {
+        while (!stop.load())
+            sig.emit(1);
+    });
+
+    std::vector<Counter> counters(threads);
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; ++t)
+    {
+        workers.emplace_back([&, t] {
+            auto del = Del::make<&Counter::add>(counters[t]);
+            for (int i = 0; i < rounds; ++i)
+            {
+                auto h = sig.connect(del);
+                ASSERT_NE(h, 0u);
+                ASSERT_TRUE(sig.disconnect(h));
+            }
+        });
+    }
+    for (auto& w : workers)
+        w.join();
+    stop.store(true);
+    emitter.join();
+
+    EXPECT_EQ(sig.size(), 1u);
+    int before = permanent.sum;
+    sig.emit(1);
+    EXPECT_EQ(permanent.sum, before + 1);
+}
@@ -0,0 +1,182 @@
+#include "delegate/shm_delegate.hpp"
+
+#include <cstdint>
+#include <new>
+
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <gtest/gtest.h>
+
+namespace
+{
+struct Account
+{
+    void deposit(int amount)
+    {
+        balance += amount;
+    }
+    void withdraw(int amount)
+    {
+        balance -= amount;
+    }
+    void audit(int) const
+    {
+        ++audits;
+    }
+    long balance = 0;
+    mutable int audits = 0;
+};
+
+using Registry =
+    shm_registry<&Account::deposit, &Account::withdraw, &Account::audit>;
+
+struct Region
+{
+    shm_queue<void(int), 8> queue;
+    Account accounts[2];
+};
+
+// The same memfd mapped twice, at two different addresses.
+struct DoubleMapping
+{
+    DoubleMapping()
+    {
+        fd = ::memfd_create("shm_delegate_test", 0);
+        EXPECT_EQ(::ftruncate(fd, sizeof(Region)), 0);
+        a = map();
+        b = map();
+    }
+    ~DoubleMapping()
+    {
+        ::munmap(a, sizeof(Region));
+        ::munmap(b, sizeof(Region));
+        ::close(fd);
+    }
+    void* map()
+    {
+        return ::mmap(nullptr, sizeof(Region), PROT_READ | PROT_WRITE,
+                      MAP_SHARED, fd, 0);
+    }
+    int fd;
+    void* a;
+    void* b;
+};
+} // namespace
+
+TEST(shm_registry, stable_ids)
+{
+    static_assert(Registry::size() == 3, "");
+    static_assert(Registry::id<&Account::deposit>() == 0, "");
+    static_assert(Registry::id<&Account::withdraw>() == 1, "");
+    static_assert(Registry::id<&Account::audit>() == 2, "");
+}
+
+TEST(shm_registry, resolve_in_other_mapping)
+{
+    DoubleMapping mapping;
+    ASSERT_NE(mapping.a, mapping.b);
+    auto* ra = new (mapping.a) Region;
+    auto* rb = static_cast<Region*>(mapping.b);
+
+    auto d = Registry::make<&Account::withdraw>(ra, ra->accounts[1]);
+    EXPECT_EQ(d.offset, sizeof(shm_queue<void(int), 8>) + sizeof(Account));
+
+    // Called through the second mapping, the object is the same.
+    Registry::resolve(d, rb, sizeof(Region))(5);
+    EXPECT_EQ(ra->accounts[1].balance, -5);
+    EXPECT_EQ(Registry::resolve(d, rb, sizeof(Region)),
+              delegate<void(int)>::make<&Account::withdraw>(rb->accounts[1]));
+
+    shm_delegate<void(int)> invalid;
+    EXPECT_TRUE(Registry::resolve(invalid, rb, sizeof(Region)).null());
+    ra->~Region();
+}
+
+TEST(shm_registry, reject_offsets_outside_region)
+{
+    DoubleMapping mapping;
+    auto* ra = new (mapping.a) Region;
+    auto* rb = static_cast<Region*>(mapping.b);
+    constexpr auto length = sizeof(Region);
+
+    // Region ending right after the object, then one byte short of it.
+    auto d = Registry::make<&Account::deposit>(ra, ra->accounts[1]);
+    auto end = d.offset + sizeof(Account);
+    EXPECT_FALSE(Registry::resolve(d, rb, end).null());
+    EXPECT_TRUE(Registry::resolve(d, rb, end - 1).null());
+
+    shm_delegate<void(int)> forged = d;
+    forged.offset = length;
+    EXPECT_TRUE(Registry::resolve(forged, rb, length).null());
+    forged.offset = ~std::uint64_t{0};
+    EXPECT_TRUE(Registry::resolve(forged, rb, length).null());
+    forged.offset = d.offset + 1; // Misaligned.
+    EXPECT_TRUE(Registry::resolve(forged, rb, length).null());
+    forged = d;
+    forged.id = 3;
+    EXPECT_TRUE(Registry::resolve(forged, rb, length).null());
+
+    // A forged call in the queue is skipped, the next one runs.
+    EXPECT_TRUE(ra->queue.try_post(shm_delegate<void(int)>{0, length}, 1));
+    EXPECT_TRUE(ra->queue.try_post(d, 2));
+    EXPECT_EQ(rb->queue.poll<Registry>(rb, length), 2u);
+    EXPECT_EQ(ra->accounts[1].balance, 2);
+    ra->~Region();
+}
+
+TEST(shm_queue, post_in_one_mapping_run_in_other)
+{
+    DoubleMapping mapping;
+    auto* ra = new (mapping.a) Region;
+    auto* rb = static_cast<Region*>(mapping.b);
+
+    auto deposit = Registry::make<&Account::deposit>(ra, ra->accounts[0]);
+    auto audit = Registry::make<&Account::audit>(ra, ra->accounts[0]);
+    for (int i = 0; i < 8; ++i)
+        EXPECT_TRUE(ra->queue.try_post(i % 2 ? deposit : audit, 10));
+    EXPECT_FALSE(ra->queue.try_post(deposit, 10));
+
+    EXPECT_EQ(rb->queue.poll<Registry>(rb, sizeof(Region), 3), 3u);
+    EXPECT_EQ(rb->queue.poll<Registry>(rb, sizeof(Region)), 5u);
+    EXPECT_EQ(rb->queue.poll<Registry>(rb, sizeof(Region)), 0u);
+    EXPECT_EQ(rb->accounts[0].balance, 40);
+    EXPECT_EQ(rb->accounts[0].audits, 4);
+    ra->~Region();
+}
+
+TEST(shm_queue, across_processes)
+{
+    DoubleMapping mapping;
+    auto* region = new (mapping.a) Region;
+    auto deposit =
+        Registry::make<&Account::deposit>(region, region->accounts[0]);
+
+    pid_t child = ::fork();
+    ASSERT_GE(child, 0);
+    if (child == 0)
+    {
+        // Remap in the child, most likely at another address.
+        void* base = mapping.map();
+        auto* r = static_cast<Region*>(base);
+        for (int i = 1; i <= 1000; ++i)
+            while (!r->queue.try_post(deposit, i))
+                ::sched_yield();
+        ::_exit(0);
+    }
+
+    int received = 0;
+    while (region->accounts[0].balance != 500500)
+    {
+        auto n = region->queue.poll<Registry>(region, sizeof(Region));
+        received += static_cast<int>(n);
+        if (n == 0)
+            ::sched_yield();
+    }
+    int status = 0;
+    ::waitpid(child, &status, 0);
+    EXPECT_EQ(status, 0);
+    EXPECT_EQ(received, 1000);
+    region->~Region();
+}
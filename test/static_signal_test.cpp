@@ -0,0 +1,105 @@
+#include "delegate/static_signal.hpp"
+
+#include <gtest/gtest.h>
+
+namespace
+{
+int s_freeSum = 0;
+
+void
+freeOnTick(int x)
+{
+    s_freeSum += x;
+}
+
+struct TickA
+{
+    void onTick(int x)
+    {
+        sum += x;
+    }
+    int sum = 0;
+};
+
+struct TickB
+{
+    void onTick(int x) const
+    {
+        calls++;
+        last = x;
+    }
+    mutable int calls = 0;
+    mutable int last = 0;
+};
+} // namespace
+
+TEST(static_signal, emit_calls_all_bound_subscribers)
+{
+    s_freeSum = 0;
+    static_signal<&TickA::onTick, &TickB::onTick, freeOnTick> sig;
+    EXPECT_EQ(sig.size(), 3u);
+
+    TickA a;
+    const TickB b;
+    sig.bind<&TickA::onTick>(a);
+    sig.bind<&TickB::onTick>(b);
+
+    sig.emit(3);
+    sig(4);
+
+    EXPECT_EQ(a.sum, 7);
+    EXPECT_EQ(b.calls, 2);
+    EXPECT_EQ(b.last, 4);
+    EXPECT_EQ(s_freeSum, 7);
+
+    // Must not compile. No storage of pointer to temporary.
+    // sig.bind<&TickA::onTick>(TickA{});
+
+    // Must not compile. Non const member needs non const object.
+    // const TickA ca; sig.bind<&TickA::onTick>(ca);
+}
+
+TEST(static_signal, unbound_members_are_skipped)
+{
+    s_freeSum = 0;
+    static_signal<&TickA::onTick, freeOnTick> sig;
+
+    sig.emit(2);
+    EXPECT_EQ(s_freeSum, 2);
+
+    TickA a;
+    sig.bind<&TickA::onTick>(a);
+    sig.emit(2);
+    EXPECT_EQ(a.sum, 2);
+
+    sig.unbind<&TickA::onTick>();
+    sig.emit(2);
+    EXPECT_EQ(a.sum, 2);
+    EXPECT_EQ(s_freeSum, 6);
+}
+
+TEST(static_signal, convert_to_runtime_delegates)
+{
+    s_freeSum = 0;
+    static_signal<&TickA::onTick, &TickB::onTick, freeOnTick> sig;
+    TickA a;
+    TickB b;
+    sig.bind<&TickA::onTick>(a);
+
+    auto dels = sig.to_delegates();
+    using Del = delegate<void(int)>;
+    EXPECT_EQ(dels.size(), 3u);
+    EXPECT_EQ(dels[0], Del::make<&TickA::onTick>(a));
+    EXPECT_TRUE(dels[1].null());
+    EXPECT_EQ(dels[2], Del::make<freeOnTick>());
+
+    sig.bind<&TickB::onTick>(b);
+    dels = sig.to_delegates();
+    EXPECT_EQ(dels[1], Del::make<&TickB::onTick>(b));
+
+    for (auto& del : dels)
+        del(5);
+    EXPECT_EQ(a.sum, 5);
+    EXPECT_EQ(b.last, 5);
+    EXPECT_EQ(s_freeSum, 5);
+}
@@ -0,0 +1,156 @@
+#include "delegate/task_graph.hpp"
+
+#include <algorithm>
+#include <mutex>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace
+{
+using Task = task_graph::Task;
+
+struct Stage
+{
+    void run()
+    {
+        std::lock_guard<std::mutex> lock(*mutex);
+        log->push_back(id);
+        if (spin.count() != 0)
+        {
+            auto end = std::chrono::steady_clock::now() + spin;
+            while (std::chrono::steady_clock::now() < end)
+                ;
+        }
+    }
+    std::mutex* mutex;
+    std::vector<int>* log;
+    int id;
+    std::chrono::microseconds spin{0};
+};
+
+std::size_t
+position(const std::vector<int>& log, int id)
+{
+    return static_cast<std::size_t>(
+        std::find(log.begin(), log.end(), id) - log.begin());
+}
+} // namespace
+
+TEST(task_graph, run_in_dependency_order)
+{
+    std::mutex mutex;
+    std::vector<int> log;
+    std::vector<Stage> stages;
+    for (int i = 0; i < 4; ++i)
+        stages.push_back(Stage{&mutex, &log, i});
+
+    // Diamond: 0 -> {1, 2} -> 3.
+    task_graph graph;
+    for (auto& s : stages)
+        graph.add(Task::make<&Stage::run>(s));
+    graph.precede(0, 1);
+    graph.precede(0, 2);
+    graph.precede(1, 3);
+    graph.precede(2, 3);
+
+    thread_pool pool{2};
+    for (int frame = 0; frame < 50; ++frame)
+    {
+        log.clear();
+        ASSERT_TRUE(graph.run(pool));
+        ASSERT_EQ(log.size(), 4u);
+        EXPECT_EQ(log.front(), 0);
+        EXPECT_EQ(log.back(), 3);
+    }
+}
+
+TEST(task_graph, independent_chains)
+{
+    std::mutex mutex;
+    std::vector<int> log;
+    std::vector<Stage> stages;
+    for (int i = 0; i < 64; ++i)
+        stages.push_back(Stage{&mutex, &log, i});
+
+    // 8 chains of 8 nodes.
+    task_graph graph;
+    for (auto& s : stages)
+        graph.add(Task::make<&Stage::run>(s));
+    for (task_graph::node_id i = 0; i < 64; ++i)
+        if (i % 8 != 7)
+            graph.precede(i, i + 1);
+
+    thread_pool pool{3, 4};
+    ASSERT_TRUE(graph.run(pool));
+    ASSERT_EQ(log.size(), 64u);
+    for (int i = 0; i < 64; ++i)
+        if (i % 8 != 7)
+        {
+            EXPECT_LT(position(log, i), position(log, i + 1));
+        }
+}
+
+TEST(task_graph, cycle_is_rejected)
+{
+    std::mutex mutex;
+    std::vector<int> log;
+    Stage a{&mutex, &log, 0}, b{&mutex, &log, 1};
+
+    task_graph graph;
+    graph.add(Task::make<&Stage::run>(a));
+    graph.add(Task::make<&Stage::run>(b));
+    graph.precede(0, 1);
+    graph.precede(1, 0);
+
+    thread_pool pool{1};
+    EXPECT_FALSE(graph.run(pool));
+    EXPECT_TRUE(log.empty());
+}
+
+TEST(task_graph, precede_rejects_unknown_nodes)
+{
+    std::mutex mutex;
+    std::vector<int> log;
+    Stage a{&mutex, &log, 0};
+
+    task_graph graph;
+    auto id = graph.add(Task::make<&Stage::run>(a));
+    EXPECT_FALSE(graph.precede(id, id + 1));
+    EXPECT_FALSE(graph.precede(id + 1, id));
+    EXPECT_FALSE(graph.precede(id, static_cast<task_graph::node_id>(-1)));
+
+    thread_pool pool{1};
+    EXPECT_TRUE(graph.run(pool));
+    EXPECT_EQ(log.size(), 1u);
+}
+
+TEST(task_graph, critical_path)
+{
+    using namespace std::chrono_literals;
+    std::mutex mutex;
+    std::vector<int> log;
+    Stage a{&mutex, &log, 0}, fast{&mutex, &log, 1}, slow{&mutex, &log, 2},
+        d{&mutex, &log, 3};
+    slow.spin = 2ms;
+
+    task_graph graph;
+    auto na = graph.add(Task::make<&Stage::run>(a));
+    auto nf = graph.add(Task::make<&Stage::run>(fast));
+    auto ns = graph.add(Task::make<&Stage::run>(slow));
+    auto nd = graph.add(Task::make<&Stage::run>(d));
+    graph.precede(na, nf);
+    graph.precede(na, ns);
+    graph.precede(nf, nd);
+    graph.precede(ns, nd);
+    graph.set_timing(true);
+
+    thread_pool pool{0};
+    ASSERT_TRUE(graph.run(pool));
+    std::vector<task_graph::node_id> path;
+    auto length = graph.critical_path(path);
+    EXPECT_EQ(path, (std::vector<task_graph::node_id>{na, ns, nd}));
+    EXPECT_GE(length, 2000000u);
+    EXPECT_LE(graph.time(na).end, graph.time(ns).start);
+    EXPECT_LE(graph.time(ns).end, graph.time(nd).start);
+}